@@ -10,6 +10,7 @@
 #include <memory>
 #include "Common.h"
 #include "ElunaUtility.h"
+#include "ElunaRefTracker.h"
 #include <type_traits>
 
 extern "C"
@@ -21,7 +22,16 @@ extern "C"
 class BaseBindingMap
 {
 public:
+    BaseBindingMap() : keepShots(false) { }
     virtual ~BaseBindingMap() = default;
+
+    /*
+     * While set, pushing references does not use up the shots of the bindings, see ElunaHookTrace::Replay.
+     */
+    void SetKeepShots(bool keep) { keepShots = keep; }
+
+protected:
+    bool keepShots;
 };
 
 /*
@@ -40,17 +50,19 @@ private:
         lua_State* L;
         uint32 remainingShots;
         int functionReference;
+        uint32 scriptId;    // script file that registered the binding, see ElunaScriptProfiler
 
-        Binding(lua_State* L, uint64 id, int functionReference, uint32 remainingShots) :
+        Binding(lua_State* L, uint64 id, int functionReference, uint32 remainingShots, uint32 scriptId) :
             id(id),
             L(L),
             remainingShots(remainingShots),
-            functionReference(functionReference)
+            functionReference(functionReference),
+            scriptId(scriptId)
         { }
 
         ~Binding()
         {
-            luaL_unref(L, LUA_REGISTRYINDEX, functionReference);
+            ELUNA_UNREF(L, functionReference);
         }
     };
 
@@ -83,11 +95,11 @@ public:
      * If `shots` is 0, it will never automatically expire, but can still be
      *   removed with `Clear` or `Remove`.
      */
-    uint64 Insert(const K& key, int ref, uint32 shots)
+    uint64 Insert(const K& key, int ref, uint32 shots, uint32 scriptId = 0)
     {
         uint64 id = (++maxBindingID);
         BindingList& list = bindings[key];
-        list.push_back(std::unique_ptr<Binding>(new Binding(L, id, ref, shots)));
+        list.push_back(std::unique_ptr<Binding>(new Binding(L, id, ref, shots, scriptId)));
         id_lookup_table[id] = &list;
         return id;
     }
@@ -175,8 +187,10 @@ public:
 
     /*
      * Push all Lua references for `key` onto the stack.
+     *
+     * If `scriptIds` is set, the script of each pushed reference is appended to it in the same order.
      */
-    void PushRefsFor(const K& key)
+    void PushRefsFor(const K& key, std::vector<uint32>* scriptIds = nullptr)
     {
         if (bindings.empty())
             return;
@@ -192,8 +206,10 @@ public:
             auto i_prev = (i++);
 
             lua_rawgeti(L, LUA_REGISTRYINDEX, binding->functionReference);
+            if (scriptIds)
+                scriptIds->push_back(binding->scriptId);
 
-            if (binding->remainingShots > 0)
+            if (binding->remainingShots > 0 && !keepShots)
             {
                 binding->remainingShots -= 1;
 
@@ -0,0 +1,101 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaAuctionSnapshot.h"
+
+#include <algorithm>
+
+void ElunaAuctionSnapshot::BuildIndex()
+{
+    // Auctions without a buyout sort last within their entry
+    std::sort(auctions.begin(), auctions.end(), [](ElunaAuction const& a, ElunaAuction const& b)
+    {
+        if (a.entry != b.entry)
+            return a.entry < b.entry;
+        if (!a.buyout != !b.buyout)
+            return a.buyout != 0;
+        if (a.GetUnitPrice() != b.GetUnitPrice())
+            return a.GetUnitPrice() < b.GetUnitPrice();
+        return a.id < b.id;
+    });
+
+    entryIndex.clear();
+    for (uint32 first = 0; first < auctions.size();)
+    {
+        uint32 last = first + 1;
+        while (last < auctions.size() && auctions[last].entry == auctions[first].entry)
+            ++last;
+
+        entryIndex[auctions[first].entry] = std::make_pair(first, last);
+        first = last;
+    }
+}
+
+bool ElunaAuctionSnapshot::Matches(Filter const& filter, ElunaAuction const& auction)
+{
+    if (filter.entry && auction.entry != filter.entry)
+        return false;
+    if (filter.seller && auction.seller != filter.seller)
+        return false;
+    if (filter.house >= 0 && auction.house != uint32(filter.house))
+        return false;
+    if ((filter.minPrice || filter.maxPrice) && !auction.buyout)
+        return false;
+    if (filter.minPrice && auction.GetUnitPrice() < filter.minPrice)
+        return false;
+    if (filter.maxPrice && auction.GetUnitPrice() > filter.maxPrice)
+        return false;
+    return true;
+}
+
+void ElunaAuctionSnapshot::Find(Filter const& filter, std::vector<ElunaAuction const*>& result) const
+{
+    uint32 first = 0;
+    uint32 last = uint32(auctions.size());
+    if (filter.entry)
+    {
+        auto itr = entryIndex.find(filter.entry);
+        if (itr == entryIndex.end())
+            return;
+
+        first = itr->second.first;
+        last = itr->second.second;
+    }
+
+    for (uint32 i = first; i < last; ++i)
+        if (Matches(filter, auctions[i]))
+            result.push_back(&auctions[i]);
+}
+
+bool ElunaAuctionSnapshot::GetStats(uint32 entry, ElunaAuctionStats& stats) const
+{
+    auto itr = entryIndex.find(entry);
+    if (itr == entryIndex.end())
+        return false;
+
+    uint32 first = itr->second.first;
+    uint32 last = itr->second.second;
+
+    stats = ElunaAuctionStats();
+    stats.auctions = last - first;
+
+    // Auctions with a buyout come first and are sorted by unit price
+    uint32 priced = first;
+    for (uint32 i = first; i < last; ++i)
+    {
+        stats.items += auctions[i].count;
+        if (auctions[i].buyout)
+            ++priced;
+    }
+
+    if (priced > first)
+    {
+        stats.minPrice = auctions[first].GetUnitPrice();
+        stats.maxPrice = auctions[priced - 1].GetUnitPrice();
+        stats.medianPrice = auctions[first + (priced - first) / 2].GetUnitPrice();
+    }
+    return true;
+}
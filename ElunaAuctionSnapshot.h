@@ -0,0 +1,89 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_AUCTION_SNAPSHOT_H
+#define _ELUNA_AUCTION_SNAPSHOT_H
+
+#include "Common.h"
+
+#include <unordered_map>
+#include <vector>
+
+struct ElunaAuction
+{
+    uint32 id;
+    uint32 house;       // 0 alliance, 1 horde, 2 neutral
+    uint32 entry;
+    uint32 count;
+    uint32 seller;      // low GUID of the owner
+    uint32 bidder;      // low GUID of the highest bidder, 0 for none
+    uint32 startBid;
+    uint32 bid;
+    uint32 buyout;
+    uint32 expireTime;
+
+    // Buyout price of a single item, 0 if the auction has no buyout
+    uint32 GetUnitPrice() const { return count ? buyout / count : buyout; }
+};
+
+struct ElunaAuctionStats
+{
+    uint32 auctions;    // amount of auctions
+    uint32 items;       // amount of items in all auctions
+    uint32 minPrice;    // lowest buyout price of a single item
+    uint32 medianPrice; // median buyout price of a single item
+    uint32 maxPrice;    // highest buyout price of a single item
+};
+
+/*
+ * Copy of the core's auction houses taken by GetAuctionSnapshot.
+ *
+ * The auctions are sorted by item entry and then by unit price, so all auctions
+ *   of an entry are a contiguous range and the cheapest auction comes first.
+ *   Auctions without a buyout have no unit price and are left out of the price statistics.
+ */
+class ElunaAuctionSnapshot
+{
+public:
+    struct Filter
+    {
+        uint32 entry = 0;
+        uint32 seller = 0;
+        int32 house = -1;
+        uint32 minPrice = 0;
+        uint32 maxPrice = 0;
+    };
+
+    void Add(ElunaAuction const& auction) { auctions.push_back(auction); }
+
+    /*
+     * Sorts the auctions and builds the entry index, must be called after all auctions are added.
+     */
+    void BuildIndex();
+
+    /*
+     * Appends the auctions matching `filter` to `result`. Uses the entry index when the filter has an entry.
+     */
+    void Find(Filter const& filter, std::vector<ElunaAuction const*>& result) const;
+
+    /*
+     * Returns `false` if there are no auctions of `entry`.
+     */
+    bool GetStats(uint32 entry, ElunaAuctionStats& stats) const;
+
+    std::vector<ElunaAuction> const& GetAuctions() const { return auctions; }
+    std::unordered_map<uint32, std::pair<uint32, uint32>> const& GetEntryIndex() const { return entryIndex; }
+
+    uint32 createTime = 0;
+
+private:
+    static bool Matches(Filter const& filter, ElunaAuction const& auction);
+
+    std::vector<ElunaAuction> auctions;
+    std::unordered_map<uint32, std::pair<uint32, uint32>> entryIndex; // entry to [first, last) range in auctions
+};
+
+#endif
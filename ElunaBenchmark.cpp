@@ -0,0 +1,224 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "Hooks.h"
+#include "HookHelpers.h"
+#include "ElunaBenchmark.h"
+#include "BindingMap.h"
+#include "ElunaEventMgr.h"
+#include "ElunaIncludes.h"
+#include "ElunaTemplate.h"
+
+#include <chrono>
+#include <memory>
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    // Scripts can not register server events past the last one, so the benchmark handlers are the only ones called
+    //   while the dispatch still goes through the state's own bindings like every hook
+    Hooks::ServerEvents const BENCHMARK_EVENT = Hooks::SERVER_EVENT_COUNT;
+
+    ElunaBenchmark::Result MakeResult(const char* name, uint32 iterations, Clock::time_point start)
+    {
+        double elapsed = double(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        return { name, iterations, iterations ? elapsed / iterations : 0.0 };
+    }
+}
+
+std::vector<ElunaBenchmark::Result> ElunaBenchmark::Run(Eluna* E, WorldObject* obj, uint32 iterations)
+{
+    std::vector<Result> results;
+    results.push_back(HookDispatch(E, iterations));
+    if (obj)
+    {
+        results.push_back(HookDispatchObject(E, obj, iterations));
+        results.push_back(PushObject(E, obj, iterations));
+        results.push_back(CheckObject(E, obj, iterations));
+        results.push_back(MethodCall(E, obj, iterations));
+#if defined LUAJIT_VERSION
+        results.push_back(FFICall(E, obj, iterations));
+#endif
+        results.push_back(MarshalGuid(E, obj, iterations));
+    }
+    results.push_back(MarshalString(E, iterations));
+    results.push_back(TimedEvents(E, iterations));
+    return results;
+}
+
+ElunaBenchmark::Result ElunaBenchmark::HookDispatch(Eluna* E, uint32 iterations)
+{
+    BindingMap<EventKey<Hooks::ServerEvents>>* binding = E->GetBinding<EventKey<Hooks::ServerEvents>>(Hooks::REGTYPE_SERVER);
+    EventKey<Hooks::ServerEvents> key(BENCHMARK_EVENT);
+    uint64 id = binding->Insert(key, RefEmptyFunction(E), 0);
+
+    Clock::time_point start = Clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        E->HookPush(i);
+        E->CallAllFunctions(binding, key);
+    }
+    Result result = MakeResult("hook_dispatch", iterations, start);
+
+    binding->Remove(id);
+    return result;
+}
+
+ElunaBenchmark::Result ElunaBenchmark::HookDispatchObject(Eluna* E, WorldObject* obj, uint32 iterations)
+{
+    BindingMap<EventKey<Hooks::ServerEvents>>* binding = E->GetBinding<EventKey<Hooks::ServerEvents>>(Hooks::REGTYPE_SERVER);
+    EventKey<Hooks::ServerEvents> key(BENCHMARK_EVENT);
+    uint64 id = binding->Insert(key, RefEmptyFunction(E), 0);
+
+    Clock::time_point start = Clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        E->HookPush(obj);
+        E->CallAllFunctions(binding, key);
+    }
+    Result result = MakeResult("hook_dispatch_object", iterations, start);
+
+    binding->Remove(id);
+    return result;
+}
+
+ElunaBenchmark::Result ElunaBenchmark::PushObject(Eluna* E, WorldObject* obj, uint32 iterations)
+{
+    int top = lua_gettop(E->L);
+
+    Clock::time_point start = Clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        E->Push(obj);
+        lua_pop(E->L, 1);
+    }
+    Result result = MakeResult("push_object", iterations, start);
+
+    lua_settop(E->L, top);
+    return result;
+}
+
+ElunaBenchmark::Result ElunaBenchmark::CheckObject(Eluna* E, WorldObject* obj, uint32 iterations)
+{
+    int top = lua_gettop(E->L);
+    E->Push(obj);
+
+    Clock::time_point start = Clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+        E->CHECKOBJ<WorldObject>(-1);
+    Result result = MakeResult("check_object", iterations, start);
+
+    lua_settop(E->L, top);
+    return result;
+}
+
+ElunaBenchmark::Result ElunaBenchmark::MethodCall(Eluna* E, WorldObject* obj, uint32 iterations)
+{
+    // The loop runs in Lua like in a script, every call goes through the method lookup and the ElunaTemplate thunk
+    int top = lua_gettop(E->L);
+    luaL_loadstring(E->L, "local obj, n = ... for i = 1, n do obj:GetEntry() end");
+    E->Push(obj);
+    E->Push(iterations);
+
+    Clock::time_point start = Clock::now();
+    if (lua_pcall(E->L, 2, 0, 0) != 0)
+        ELUNA_LOG_ERROR("[Eluna]: Benchmark method_call failed: %s", lua_tostring(E->L, -1));
+    Result result = MakeResult("method_call", iterations, start);
+
+    lua_settop(E->L, top);
+    return result;
+}
+
+ElunaBenchmark::Result ElunaBenchmark::FFICall(Eluna* E, WorldObject* obj, uint32 iterations)
+{
+    // The same loop as method_call through the ElunaFFI getter, which the compiler can keep compiled
+    int top = lua_gettop(E->L);
+    luaL_loadstring(E->L, "local obj, n = ... local GetEntry = ElunaFFI.GetEntry for i = 1, n do GetEntry(obj) end");
+    E->Push(obj);
+    E->Push(iterations);
+
+    Clock::time_point start = Clock::now();
+    if (lua_pcall(E->L, 2, 0, 0) != 0)
+        ELUNA_LOG_ERROR("[Eluna]: Benchmark ffi_call failed: %s", lua_tostring(E->L, -1));
+    Result result = MakeResult("ffi_call", iterations, start);
+
+    lua_settop(E->L, top);
+    return result;
+}
+
+ElunaBenchmark::Result ElunaBenchmark::MarshalGuid(Eluna* E, WorldObject* obj, uint32 iterations)
+{
+    int top = lua_gettop(E->L);
+    ObjectGuid guid = obj->GET_GUID();
+
+    Clock::time_point start = Clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        E->Push(guid);
+        E->CHECKVAL<ObjectGuid>(-1);
+        lua_pop(E->L, 1);
+    }
+    Result result = MakeResult("marshal_guid", iterations, start);
+
+    lua_settop(E->L, top);
+    return result;
+}
+
+ElunaBenchmark::Result ElunaBenchmark::MarshalString(Eluna* E, uint32 iterations)
+{
+    int top = lua_gettop(E->L);
+    std::string value = "Eluna benchmark string";
+
+    Clock::time_point start = Clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        E->Push(value);
+        E->CHECKVAL<std::string>(-1);
+        lua_pop(E->L, 1);
+    }
+    Result result = MakeResult("marshal_string", iterations, start);
+
+    lua_settop(E->L, top);
+    return result;
+}
+
+ElunaBenchmark::Result ElunaBenchmark::TimedEvents(Eluna* E, uint32 iterations)
+{
+    // Events are added and removed without being called, calling them costs the same as a hook dispatch.
+    //   Calling them here would also not be possible from inside a hook, see Eluna::OnTimedEvent
+    // The function is compiled once, every event still owns a reference to it like one made with RegisterEvent
+    luaL_loadstring(E->L, "");
+
+    // The processor is destroyed outside of the measured block, unreferencing the events is not part of scheduling them
+    std::unique_ptr<ElunaEventProcessor> processor = std::make_unique<ElunaEventProcessor>(E->eventMgr.get(), nullptr);
+
+    Clock::time_point start = Clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        lua_pushvalue(E->L, -1);
+        processor->AddEvent(ELUNA_REF(E->L, ELUNA_REF_TIMED_EVENT), 1 + i % 100, 1 + i % 100, 1);
+    }
+    Result result = MakeResult("timed_events", iterations, start);
+
+    processor.reset();
+    lua_pop(E->L, 1);
+    return result;
+}
+
+ElunaBenchmark::Result ElunaBenchmark::Reload(Eluna* E, uint32 iterations)
+{
+    Clock::time_point start = Clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+        E->_ReloadEluna();
+    return MakeResult("reload", iterations, start);
+}
+
+int ElunaBenchmark::RefEmptyFunction(Eluna* E)
+{
+    luaL_loadstring(E->L, "");
+    return ELUNA_REF(E->L, ELUNA_REF_BINDING);
+}
@@ -0,0 +1,59 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_BENCHMARK_H
+#define _ELUNA_BENCHMARK_H
+
+#include "Common.h"
+
+#include <string>
+#include <vector>
+
+class Eluna;
+class WorldObject;
+
+/*
+ * Microbenchmarks of the engine paths every script goes through, run inside a live state with RunBenchmarks.
+ *
+ * The benchmarks add empty handlers to the state's bindings under an event scripts can not register
+ *   and use their own event processor, so they measure the cost of Eluna itself and never call handlers
+ *   registered by scripts.
+ *   The object benchmarks are only run when an object is given, the ElunaFFI one only when built against LuaJIT.
+ */
+class ElunaBenchmark
+{
+public:
+    struct Result
+    {
+        std::string name;
+        uint32 iterations;
+        double nanoseconds;     // average time of one iteration
+    };
+
+    static std::vector<Result> Run(Eluna* E, WorldObject* obj, uint32 iterations);
+
+    /*
+     * Closes the state, opens it again and runs its scripts `iterations` times, the work of a reload.
+     *   Needs the state to be idle, so it can not be run from a script. See tools/mockhost.
+     */
+    static Result Reload(Eluna* E, uint32 iterations);
+
+private:
+    static Result HookDispatch(Eluna* E, uint32 iterations);
+    static Result HookDispatchObject(Eluna* E, WorldObject* obj, uint32 iterations);
+    static Result PushObject(Eluna* E, WorldObject* obj, uint32 iterations);
+    static Result CheckObject(Eluna* E, WorldObject* obj, uint32 iterations);
+    static Result MethodCall(Eluna* E, WorldObject* obj, uint32 iterations);
+    static Result FFICall(Eluna* E, WorldObject* obj, uint32 iterations);
+    static Result MarshalGuid(Eluna* E, WorldObject* obj, uint32 iterations);
+    static Result MarshalString(Eluna* E, uint32 iterations);
+    static Result TimedEvents(Eluna* E, uint32 iterations);
+
+    // Pushes a function that does nothing and returns a reference to it
+    static int RefEmptyFunction(Eluna* E);
+};
+
+#endif
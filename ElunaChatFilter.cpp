@@ -0,0 +1,291 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaChatFilter.h"
+#include "ElunaRefTracker.h"
+#include "Hooks.h"
+
+#include <algorithm>
+#include <deque>
+
+extern "C"
+{
+#include "lua.h"
+#include "lauxlib.h"
+};
+
+namespace
+{
+    const uint32 NO_NODE = 0xFFFFFFFF;
+    const uint8 SEPARATOR = ' ';
+
+    struct Symbol
+    {
+        uint8 symbol;
+        size_t begin;
+        size_t end;
+    };
+
+    // Maps a byte to its normalized symbol, 0 means the byte is skipped
+    uint8 Normalize(uint8 c)
+    {
+        if (c >= 'A' && c <= 'Z')
+            return c - 'A' + 'a';
+        if ((c >= 'a' && c <= 'z') || c >= 0x80)
+            return c;
+
+        switch (c)
+        {
+            case '0': return 'o';
+            case '1': return 'i';
+            case '3': return 'e';
+            case '4': return 'a';
+            case '5': return 's';
+            case '7': return 't';
+            case '8': return 'b';
+            case '@': return 'a';
+            case '$': return 's';
+            case '!': return 'i';
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                return SEPARATOR;
+            default:
+                break;
+        }
+
+        if (c >= '0' && c <= '9')
+            return c;
+        return 0;
+    }
+
+    void NormalizeText(std::string const& text, std::vector<Symbol>& symbols)
+    {
+        symbols.clear();
+        symbols.reserve(text.size());
+
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            // Skip chat link and color escapes, the visible part of links is still searched
+            if (text[i] == '|' && i + 1 < text.size())
+            {
+                char code = text[i + 1];
+                if (code == 'c' && i + 10 <= text.size())
+                {
+                    i += 9;
+                    continue;
+                }
+                if (code == 'H')
+                {
+                    size_t end = text.find("|h", i + 2);
+                    if (end != std::string::npos)
+                    {
+                        i = end + 1;
+                        continue;
+                    }
+                }
+                if (code == 'h' || code == 'r')
+                {
+                    ++i;
+                    continue;
+                }
+            }
+
+            uint8 symbol = Normalize(static_cast<uint8>(text[i]));
+            if (!symbol)
+                continue;
+
+            // Collapse repeated characters, the match spans the whole run
+            if (!symbols.empty() && symbols.back().symbol == symbol)
+            {
+                symbols.back().end = i + 1;
+                continue;
+            }
+
+            symbols.push_back({ symbol, i, i + 1 });
+        }
+    }
+}
+
+ChatFilterAutomaton::ChatFilterAutomaton(std::vector<std::string> const& words, bool wholeWords) : words(words), wholeWords(wholeWords)
+{
+    Build();
+}
+
+uint32 ChatFilterAutomaton::Goto(uint32 node, uint8 symbol) const
+{
+    std::vector<Edge> const& edges = nodes[node].edges;
+    auto it = std::lower_bound(edges.begin(), edges.end(), symbol, [](Edge const& edge, uint8 s) { return edge.symbol < s; });
+    if (it == edges.end() || it->symbol != symbol)
+        return NO_NODE;
+    return it->target;
+}
+
+uint32 ChatFilterAutomaton::Next(uint32 node, uint8 symbol) const
+{
+    uint32 target = Goto(node, symbol);
+    while (target == NO_NODE && node != 0)
+    {
+        node = nodes[node].fail;
+        target = Goto(node, symbol);
+    }
+    return target == NO_NODE ? 0 : target;
+}
+
+void ChatFilterAutomaton::Build()
+{
+    nodes.clear();
+    nodes.emplace_back();
+
+    std::vector<Symbol> symbols;
+    for (size_t w = 0; w < words.size(); ++w)
+    {
+        NormalizeText(words[w], symbols);
+
+        // Separators at the edges of a word would never match at the edges of a message
+        while (!symbols.empty() && symbols.back().symbol == SEPARATOR)
+            symbols.pop_back();
+        size_t first = 0;
+        while (first < symbols.size() && symbols[first].symbol == SEPARATOR)
+            ++first;
+        if (first == symbols.size())
+            continue;
+
+        uint32 node = 0;
+        for (size_t i = first; i < symbols.size(); ++i)
+        {
+            uint8 symbol = symbols[i].symbol;
+            uint32 next = Goto(node, symbol);
+            if (next == NO_NODE)
+            {
+                next = uint32(nodes.size());
+                nodes.emplace_back();
+                nodes[next].depth = nodes[node].depth + 1;
+
+                std::vector<Edge>& edges = nodes[node].edges;
+                auto it = std::lower_bound(edges.begin(), edges.end(), symbol, [](Edge const& edge, uint8 s) { return edge.symbol < s; });
+                edges.insert(it, { symbol, next });
+            }
+            node = next;
+        }
+
+        if (nodes[node].word < 0)
+            nodes[node].word = int32(w);
+    }
+
+    // Breadth first so that fail links always point to already processed nodes
+    std::deque<uint32> queue;
+    for (Edge const& edge : nodes[0].edges)
+        queue.push_back(edge.target);
+
+    while (!queue.empty())
+    {
+        uint32 node = queue.front();
+        queue.pop_front();
+
+        for (Edge const& edge : nodes[node].edges)
+        {
+            uint32 child = edge.target;
+            uint32 fail = node == 0 ? 0 : Next(nodes[node].fail, edge.symbol);
+            if (fail == child)
+                fail = 0;
+
+            nodes[child].fail = fail;
+            nodes[child].output = nodes[fail].word >= 0 ? fail : nodes[fail].output;
+            queue.push_back(child);
+        }
+    }
+}
+
+bool ChatFilterAutomaton::Search(std::string const& text, std::vector<ChatFilterMatch>& matches) const
+{
+    if (nodes.size() <= 1)
+        return false;
+
+    std::vector<Symbol> symbols;
+    NormalizeText(text, symbols);
+
+    size_t found = matches.size();
+    uint32 state = 0;
+    for (size_t i = 0; i < symbols.size(); ++i)
+    {
+        state = Next(state, symbols[i].symbol);
+
+        for (uint32 node = nodes[state].word >= 0 ? state : nodes[state].output; node != 0; node = nodes[node].output)
+        {
+            size_t first = i + 1 - nodes[node].depth;
+            if (wholeWords)
+            {
+                if (first > 0 && symbols[first - 1].symbol != SEPARATOR)
+                    continue;
+                if (i + 1 < symbols.size() && symbols[i + 1].symbol != SEPARATOR)
+                    continue;
+            }
+
+            matches.push_back({ symbols[first].begin, symbols[i].end, uint32(nodes[node].word) });
+        }
+    }
+
+    return matches.size() != found;
+}
+
+ElunaChatFilterMgr::ElunaChatFilterMgr(lua_State* L) : L(L), maxFilterID(0), eventMask(0)
+{
+}
+
+ElunaChatFilterMgr::~ElunaChatFilterMgr()
+{
+    Clear();
+}
+
+uint32 ElunaChatFilterMgr::GetEventMask(uint32 event)
+{
+    switch (event)
+    {
+        case Hooks::PLAYER_EVENT_ON_CHAT:
+        case Hooks::PLAYER_EVENT_ON_WHISPER:
+        case Hooks::PLAYER_EVENT_ON_GROUP_CHAT:
+        case Hooks::PLAYER_EVENT_ON_GUILD_CHAT:
+        case Hooks::PLAYER_EVENT_ON_CHANNEL_CHAT:
+            return 1 << (event - Hooks::PLAYER_EVENT_ON_CHAT);
+        default:
+            return 0;
+    }
+}
+
+uint64 ElunaChatFilterMgr::Add(uint32 events, std::vector<std::string> const& words, bool wholeWords, int ref)
+{
+    filters.push_back(std::unique_ptr<Filter>(new Filter{ ++maxFilterID, events, ref, ChatFilterAutomaton(words, wholeWords) }));
+    UpdateEventMask();
+    return maxFilterID;
+}
+
+void ElunaChatFilterMgr::Remove(uint64 id)
+{
+    auto it = std::find_if(filters.begin(), filters.end(), [id](std::unique_ptr<Filter> const& filter) { return filter->id == id; });
+    if (it == filters.end())
+        return;
+
+    ELUNA_UNREF(L, (*it)->functionReference);
+    filters.erase(it);
+    UpdateEventMask();
+}
+
+void ElunaChatFilterMgr::Clear()
+{
+    for (std::unique_ptr<Filter> const& filter : filters)
+        ELUNA_UNREF(L, filter->functionReference);
+    filters.clear();
+    eventMask = 0;
+}
+
+void ElunaChatFilterMgr::UpdateEventMask()
+{
+    eventMask = 0;
+    for (std::unique_ptr<Filter> const& filter : filters)
+        eventMask |= filter->events;
+}
@@ -0,0 +1,116 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_CHAT_FILTER_H
+#define _ELUNA_CHAT_FILTER_H
+
+#include "Common.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+struct lua_State;
+
+struct ChatFilterMatch
+{
+    size_t begin;  // offset of the first byte of the match in the original message
+    size_t end;    // offset one past the last byte of the match in the original message
+    uint32 word;   // index of the matched word in the word list
+};
+
+/*
+ * Aho-Corasick automaton over a normalized alphabet.
+ *
+ * Both the word list and the searched text are normalized the same way:
+ *   ASCII letters are lowercased, common leetspeak substitutions are mapped
+ *   to letters, punctuation inside words is skipped and runs of the same
+ *   character are collapsed. "B.@.d", "baaad" and "bad" all match "bad".
+ *   Match offsets always refer to the original, unnormalized text.
+ */
+class ChatFilterAutomaton
+{
+public:
+    ChatFilterAutomaton(std::vector<std::string> const& words, bool wholeWords);
+
+    /*
+     * Appends every match in `text` to `matches`. Returns `true` if anything matched.
+     */
+    bool Search(std::string const& text, std::vector<ChatFilterMatch>& matches) const;
+
+    std::string const& GetWord(uint32 index) const { return words[index]; }
+    size_t GetWordCount() const { return words.size(); }
+
+private:
+    struct Edge
+    {
+        uint8 symbol;
+        uint32 target;
+    };
+
+    struct Node
+    {
+        std::vector<Edge> edges; // sorted by symbol
+        uint32 fail = 0;
+        uint32 output = 0;       // next node on the fail chain with a word, 0 for none
+        int32 word = -1;         // word ending at this node
+        uint32 depth = 0;        // length of the normalized prefix
+    };
+
+    uint32 Goto(uint32 node, uint8 symbol) const;
+    uint32 Next(uint32 node, uint8 symbol) const;
+    void Build();
+
+    std::vector<std::string> words;
+    std::vector<Node> nodes;
+    bool wholeWords;
+};
+
+/*
+ * Per-state list of chat filters registered with RegisterChatFilter.
+ */
+class ElunaChatFilterMgr
+{
+public:
+    struct Filter
+    {
+        uint64 id;
+        uint32 events;  // bit mask of the player chat events the filter is attached to
+        int functionReference;
+        ChatFilterAutomaton automaton;
+    };
+
+    ElunaChatFilterMgr(lua_State* L);
+    ~ElunaChatFilterMgr();
+
+    ElunaChatFilterMgr(ElunaChatFilterMgr const&) = delete;
+    ElunaChatFilterMgr& operator=(ElunaChatFilterMgr const&) = delete;
+
+    /*
+     * Returns the event mask bit of a chat event, or 0 if `event` is not a chat event.
+     */
+    static uint32 GetEventMask(uint32 event);
+
+    /*
+     * Adds a filter attached to the events in `events`. Takes ownership of `ref`.
+     */
+    uint64 Add(uint32 events, std::vector<std::string> const& words, bool wholeWords, int ref);
+    void Remove(uint64 id);
+    void Clear();
+
+    bool HasFiltersFor(uint32 event) const { return (eventMask & GetEventMask(event)) != 0; }
+    std::vector<std::unique_ptr<Filter>> const& GetFilters() const { return filters; }
+
+private:
+    void UpdateEventMask();
+
+    lua_State* L;
+    std::vector<std::unique_ptr<Filter>> filters;
+    uint64 maxFilterID;
+    uint32 eventMask;
+};
+
+#endif
@@ -0,0 +1,205 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaChromeTrace.h"
+#include "ElunaConfig.h"
+#include "ElunaUtility.h"
+
+
+namespace
+{
+    // Recorders write their events to the file once they buffered this many bytes
+    const size_t FLUSH_SIZE = 64 * 1024;
+
+    // or once this many milliseconds passed, whichever comes first
+    const uint32 FLUSH_INTERVAL = 1000;
+
+    // Small sequential thread IDs are easier to read in trace viewers than native ones
+    uint32 GetThreadId()
+    {
+        static std::atomic<uint32> nextThreadId(1);
+        thread_local uint32 threadId = nextThreadId++;
+        return threadId;
+    }
+}
+
+ElunaChromeTrace::Recorder::Recorder(int32 mapId, uint32 instanceId) :
+    session(sElunaChromeTrace->GetSession()), mapId(mapId), instanceId(instanceId), flushTimer(0)
+{
+}
+
+ElunaChromeTrace::Recorder::~Recorder()
+{
+    Flush();
+}
+
+void ElunaChromeTrace::Recorder::WriteEvent(const char* category, std::string const& name, char phase, uint64 timestamp, uint64 duration, std::string const& args)
+{
+    // States can move between map update threads, so the thread is looked up for every event
+    char header[192];
+    snprintf(header, sizeof(header), "\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%llu,\"pid\":1,\"tid\":%u", category, phase,
+        static_cast<unsigned long long>(timestamp), GetThreadId());
+
+    buffer += buffer.empty() ? "{\"name\":\"" : ",\n{\"name\":\"";
+    buffer += Escape(name);
+    buffer += "\",";
+    buffer += header;
+    if (phase == 'X')
+    {
+        buffer += ",\"dur\":";
+        buffer += std::to_string(duration);
+    }
+
+    char location[64];
+    snprintf(location, sizeof(location), ",\"args\":{\"map\":%i,\"instance\":%u", mapId, instanceId);
+    buffer += location;
+    if (!args.empty())
+    {
+        buffer += ',';
+        buffer += args;
+    }
+    buffer += "}}";
+
+    if (buffer.size() >= FLUSH_SIZE)
+        Flush();
+}
+
+void ElunaChromeTrace::Recorder::Complete(const char* category, std::string const& name, uint64 start, std::string const& args)
+{
+    WriteEvent(category, name, 'X', start, ElunaUtil::GetCurrTimeUs() - start, args);
+}
+
+void ElunaChromeTrace::Recorder::Counter(const char* name, std::string const& args)
+{
+    WriteEvent("lua", name, 'C', ElunaUtil::GetCurrTimeUs(), 0, args);
+}
+
+void ElunaChromeTrace::Recorder::BeginHook(uint8 regtype, uint32 event, uint32 entry)
+{
+    hooks.push_back({ ElunaUtil::GetCurrTimeUs(), regtype, event, entry });
+}
+
+void ElunaChromeTrace::Recorder::EndHook()
+{
+    if (hooks.empty())
+        return;
+
+    Hook const& hook = hooks.back();
+    char name[48];
+    snprintf(name, sizeof(name), "regtype %u event %u", hook.regtype, hook.event);
+    Complete("hook", name, hook.start, "\"entry\":" + std::to_string(hook.entry));
+    hooks.pop_back();
+}
+
+void ElunaChromeTrace::Recorder::Update(uint32 diff)
+{
+    flushTimer += diff;
+    if (flushTimer >= FLUSH_INTERVAL)
+        Flush();
+}
+
+void ElunaChromeTrace::Recorder::Flush()
+{
+    flushTimer = 0;
+    if (buffer.empty())
+        return;
+
+    sElunaChromeTrace->Write(session, buffer);
+    buffer.clear();
+}
+
+ElunaChromeTrace::ElunaChromeTrace() : file(nullptr), empty(true), configStarted(false), active(false), session(0)
+{
+}
+
+ElunaChromeTrace::~ElunaChromeTrace()
+{
+    Stop();
+}
+
+ElunaChromeTrace* ElunaChromeTrace::instance()
+{
+    static ElunaChromeTrace instance;
+    return &instance;
+}
+
+std::string ElunaChromeTrace::Escape(std::string const& str)
+{
+    std::string escaped;
+    escaped.reserve(str.size());
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if (uint8(c) < 0x20)
+        {
+            char code[8];
+            snprintf(code, sizeof(code), "\\u%04x", uint8(c));
+            escaped += code;
+        }
+        else
+            escaped += c;
+    }
+    return escaped;
+}
+
+bool ElunaChromeTrace::Start(std::string const& path)
+{
+    Stop();
+
+    std::lock_guard<std::mutex> guard(lock);
+    file = fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        ELUNA_LOG_ERROR("[Eluna]: Could not open `%s` to write a Chrome trace to", path.c_str());
+        return false;
+    }
+
+    fputs("[\n", file);
+    empty = true;
+    ++session;
+    active = true;
+    ELUNA_LOG_INFO("[Eluna]: Writing a Chrome trace to `%s`", path.c_str());
+    return true;
+}
+
+void ElunaChromeTrace::Stop()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (!file)
+        return;
+
+    active = false;
+    fputs("\n]\n", file);
+    fclose(file);
+    file = nullptr;
+}
+
+void ElunaChromeTrace::StartFromConfig()
+{
+    if (configStarted)
+        return;
+    configStarted = true;
+
+    std::string const& path = sElunaConfig->GetConfig(CONFIG_ELUNA_CHROME_TRACE);
+    if (!path.empty())
+        Start(path);
+}
+
+void ElunaChromeTrace::Write(uint32 eventSession, std::string const& events)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (!file || eventSession != session)
+        return;
+
+    if (!empty)
+        fputs(",\n", file);
+    fwrite(events.data(), 1, events.size(), file);
+    empty = false;
+}
@@ -0,0 +1,114 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_CHROME_TRACE_H
+#define _ELUNA_CHROME_TRACE_H
+
+#include "Common.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * Writes the Lua activity of all states to a file in the Chrome trace event format,
+ *   which can be opened in chrome://tracing, Perfetto or Speedscope.
+ *
+ * Every state records its hook dispatches, handler calls, timed events, script runs, reloads
+ *   and heap size into its own recorder, which writes its events to the shared file in blocks.
+ *   The script loader records its phases the same way. Events are tagged with the map and instance
+ *   of their state and with the thread they ran on.
+ *
+ * A trace is started with Eluna.ChromeTrace or StartChromeTrace, and states pick it up on their next update.
+ */
+class ElunaChromeTrace
+{
+public:
+    /*
+     * Events of one state, or of the loader. Only used by one thread at a time.
+     */
+    class Recorder
+    {
+    public:
+        Recorder(int32 mapId, uint32 instanceId);
+        ~Recorder();
+
+        Recorder(Recorder const&) = delete;
+        Recorder& operator=(Recorder const&) = delete;
+
+        uint32 GetSession() const { return session; }
+
+        /*
+         * Records an event that started at `start` and ended now. `args` are extra JSON members, like "\"id\":1".
+         */
+        void Complete(const char* category, std::string const& name, uint64 start, std::string const& args = std::string());
+        void Counter(const char* name, std::string const& args);
+
+        // Hook dispatches in progress, see SetupStack and CleanUpStack
+        void BeginHook(uint8 regtype, uint32 event, uint32 entry);
+        void EndHook();
+
+        // Writes the buffered events once a second, so a quiet state's events still reach the file
+        void Update(uint32 diff);
+        void Flush();
+
+    private:
+        struct Hook
+        {
+            uint64 start;
+            uint8 regtype;
+            uint32 event;
+            uint32 entry;
+        };
+
+        void WriteEvent(const char* category, std::string const& name, char phase, uint64 timestamp, uint64 duration, std::string const& args);
+
+        uint32 session;
+        int32 mapId;
+        uint32 instanceId;
+        uint32 flushTimer;
+        std::string buffer;
+        std::vector<Hook> hooks;
+    };
+
+    static ElunaChromeTrace* instance();
+
+    static std::string Escape(std::string const& str);
+
+    /*
+     * Starts writing a trace to `path`, stopping a running one first. Returns false if the file can not be opened.
+     */
+    bool Start(std::string const& path);
+    void Stop();
+
+    // Starts the trace set with Eluna.ChromeTrace, only the first time it is called
+    void StartFromConfig();
+
+    bool IsActive() const { return active.load(std::memory_order_relaxed); }
+    uint32 GetSession() const { return session.load(std::memory_order_relaxed); }
+
+private:
+    ElunaChromeTrace();
+    ~ElunaChromeTrace();
+    ElunaChromeTrace(ElunaChromeTrace const&) = delete;
+    ElunaChromeTrace& operator=(ElunaChromeTrace const&) = delete;
+
+    // Appends events recorded for `session`, they are dropped if that trace was stopped
+    void Write(uint32 session, std::string const& events);
+
+    std::mutex lock;
+    FILE* file;
+    bool empty;
+    bool configStarted;
+    std::atomic<bool> active;
+    std::atomic<uint32> session;
+};
+
+#define sElunaChromeTrace ElunaChromeTrace::instance()
+
+#endif
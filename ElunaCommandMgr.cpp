@@ -0,0 +1,453 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaCommandMgr.h"
+#include "ElunaRefTracker.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+extern "C"
+{
+#include "lua.h"
+#include "lauxlib.h"
+};
+
+static bool IsSpace(char c)
+{
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+static std::string ToLower(std::string str)
+{
+    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return std::tolower(c); });
+    return str;
+}
+
+// Reads the next whitespace separated word starting at `pos` and moves `pos` past it
+static std::string NextWord(const char* text, size_t& pos)
+{
+    while (text[pos] && IsSpace(text[pos]))
+        ++pos;
+
+    size_t begin = pos;
+    while (text[pos] && !IsSpace(text[pos]))
+        ++pos;
+
+    return std::string(text + begin, pos - begin);
+}
+
+static void SplitPath(const std::string& path, std::vector<std::string>& words)
+{
+    size_t pos = 0;
+    for (std::string word = NextWord(path.c_str(), pos); !word.empty(); word = NextWord(path.c_str(), pos))
+        words.push_back(ToLower(word));
+}
+
+ElunaCommandMgr::ElunaCommandMgr(lua_State* L) : L(L), maxCommandID(0), commandCount(0)
+{
+}
+
+ElunaCommandMgr::~ElunaCommandMgr()
+{
+    Clear();
+}
+
+bool ElunaCommandMgr::ParseArgSpec(const std::string& spec, std::vector<ElunaCommandArg>& args, std::string& error)
+{
+    std::vector<std::string> tokens;
+    SplitPath(spec, tokens);
+
+    bool hadOptional = false;
+    for (size_t i = 0; i < tokens.size(); ++i)
+    {
+        std::string token = tokens[i];
+
+        ElunaCommandArg arg;
+        arg.optional = !token.empty() && token.back() == '?';
+        if (arg.optional)
+            token.pop_back();
+
+        if (hadOptional && !arg.optional)
+        {
+            error = "required argument `" + token + "` can not follow an optional argument";
+            return false;
+        }
+        hadOptional = hadOptional || arg.optional;
+
+        if (token == "int")
+            arg.type = COMMAND_ARG_INT;
+        else if (token == "uint")
+            arg.type = COMMAND_ARG_UINT;
+        else if (token == "number")
+            arg.type = COMMAND_ARG_NUMBER;
+        else if (token == "player")
+            arg.type = COMMAND_ARG_PLAYER;
+        else if (token == "string")
+            arg.type = COMMAND_ARG_STRING;
+        else if (token == "rest")
+            arg.type = COMMAND_ARG_REST;
+        else if (token.compare(0, 4, "link") == 0 && (token.size() == 4 || token[4] == ':'))
+        {
+            arg.type = COMMAND_ARG_LINK;
+            if (token.size() > 5)
+                arg.linkType = token.substr(5);
+        }
+        else
+        {
+            error = "unknown argument type `" + token + "`";
+            return false;
+        }
+
+        if (arg.type == COMMAND_ARG_REST && i + 1 != tokens.size())
+        {
+            error = "`rest` must be the last argument";
+            return false;
+        }
+
+        args.push_back(arg);
+    }
+
+    return true;
+}
+
+uint64 ElunaCommandMgr::Insert(const std::string& path, uint32 security, std::vector<ElunaCommandArg>&& args, int ref)
+{
+    std::vector<std::string> words;
+    SplitPath(path, words);
+    if (words.empty())
+    {
+        ELUNA_UNREF(L, ref);
+        return 0;
+    }
+
+    Node* node = &root;
+    std::string normalized;
+    for (const std::string& word : words)
+    {
+        std::unique_ptr<Node>& child = node->children[word];
+        if (!child)
+            child = std::make_unique<Node>();
+        node = child.get();
+
+        if (!normalized.empty())
+            normalized += ' ';
+        normalized += word;
+    }
+
+    if (node->command)
+        Release(*node->command);
+    else
+        ++commandCount;
+
+    node->command = std::make_unique<ElunaCommand>();
+    node->command->id = ++maxCommandID;
+    node->command->security = security;
+    node->command->functionReference = ref;
+    node->command->path = normalized;
+    node->command->args = std::move(args);
+
+    id_lookup_table[node->command->id] = normalized;
+    return node->command->id;
+}
+
+void ElunaCommandMgr::Remove(uint64 id)
+{
+    auto iter = id_lookup_table.find(id);
+    if (iter == id_lookup_table.end())
+        return;
+
+    std::vector<std::string> words;
+    SplitPath(iter->second, words);
+    id_lookup_table.erase(iter);
+
+    // path[i] is the parent of the node of words[i]
+    std::vector<Node*> path = { &root };
+    for (const std::string& word : words)
+    {
+        auto child = path.back()->children.find(word);
+        if (child == path.back()->children.end())
+            return;
+        path.push_back(child->second.get());
+    }
+
+    Node* node = path.back();
+    if (!node->command || node->command->id != id)
+        return;
+
+    Release(*node->command);
+    node->command.reset();
+    --commandCount;
+
+    // Drop the nodes left without commands, so they no longer take part in abbreviation matching
+    for (size_t i = words.size(); i > 0; --i)
+    {
+        Node* child = path[i];
+        if (child->command || !child->children.empty())
+            break;
+        path[i - 1]->children.erase(words[i - 1]);
+    }
+}
+
+void ElunaCommandMgr::Clear()
+{
+    std::vector<Node*> stack = { &root };
+    while (!stack.empty())
+    {
+        Node* node = stack.back();
+        stack.pop_back();
+
+        if (node->command)
+            Release(*node->command);
+
+        for (auto& child : node->children)
+            stack.push_back(child.second.get());
+    }
+
+    root.children.clear();
+    root.command.reset();
+    id_lookup_table.clear();
+    commandCount = 0;
+}
+
+void ElunaCommandMgr::Release(ElunaCommand& command)
+{
+    id_lookup_table.erase(command.id);
+    ELUNA_UNREF(L, command.functionReference);
+}
+
+ElunaCommandMgr::Node const* ElunaCommandMgr::FindChild(Node const* node, const std::string& word) const
+{
+    auto exact = node->children.find(word);
+    if (exact != node->children.end())
+        return exact->second.get();
+
+    // Allow unambiguous abbreviations like the core command tables do
+    Node const* match = nullptr;
+    for (auto const& child : node->children)
+    {
+        if (child.first.compare(0, word.size(), word) != 0)
+            continue;
+
+        if (match)
+            return nullptr;
+        match = child.second.get();
+    }
+    return match;
+}
+
+ElunaCommand const* ElunaCommandMgr::Find(const char* text, size_t& argsBegin) const
+{
+    if (!text || IsEmpty())
+        return nullptr;
+
+    ElunaCommand const* found = nullptr;
+    Node const* node = &root;
+    size_t pos = 0;
+
+    for (std::string word = NextWord(text, pos); !word.empty(); word = NextWord(text, pos))
+    {
+        node = FindChild(node, ToLower(word));
+        if (!node)
+            break;
+
+        if (node->command)
+        {
+            found = node->command.get();
+            argsBegin = pos;
+        }
+    }
+
+    return found;
+}
+
+static bool ParseLink(const std::string& text, const std::string& expectedType, double& id, std::string& linkType)
+{
+    // Format: [|cAARRGGBB]|Htype:id[:more...]|h[name]|h[|r]
+    size_t start = text.find("|H");
+    if (start == std::string::npos)
+        return false;
+
+    size_t typeEnd = text.find(':', start + 2);
+    if (typeEnd == std::string::npos)
+        return false;
+
+    linkType = ToLower(text.substr(start + 2, typeEnd - start - 2));
+    if (!expectedType.empty() && linkType != expectedType)
+        return false;
+
+    const char* idBegin = text.c_str() + typeEnd + 1;
+    char* idEnd = nullptr;
+    errno = 0;
+    unsigned long long value = std::strtoull(idBegin, &idEnd, 10);
+    if (idEnd == idBegin || errno == ERANGE || (*idEnd != ':' && *idEnd != '|'))
+        return false;
+
+    id = static_cast<double>(value);
+    return true;
+}
+
+static bool ParseNumber(const std::string& token, ElunaCommandArgType type, double& value)
+{
+    if (token.empty())
+        return false;
+
+    char* end = nullptr;
+    errno = 0;
+    if (type == COMMAND_ARG_NUMBER)
+        value = std::strtod(token.c_str(), &end);
+    else if (type == COMMAND_ARG_INT)
+        value = static_cast<double>(std::strtoll(token.c_str(), &end, 10));
+    else
+    {
+        if (token[0] == '-')
+            return false;
+        value = static_cast<double>(std::strtoull(token.c_str(), &end, 10));
+    }
+
+    return errno != ERANGE && end && *end == '\0';
+}
+
+bool ElunaCommandMgr::ParseArgs(ElunaCommand const& command, const char* text, std::vector<ElunaCommandValue>& values, std::string& error)
+{
+    size_t pos = 0;
+    values.reserve(command.args.size());
+
+    for (ElunaCommandArg const& arg : command.args)
+    {
+        while (text[pos] && IsSpace(text[pos]))
+            ++pos;
+
+        ElunaCommandValue value;
+        value.type = arg.type;
+        value.present = text[pos] != '\0';
+        value.number = 0;
+
+        if (!value.present)
+        {
+            if (!arg.optional)
+            {
+                error = "missing argument " + std::to_string(values.size() + 1);
+                return false;
+            }
+            values.push_back(value);
+            continue;
+        }
+
+        switch (arg.type)
+        {
+            case COMMAND_ARG_INT:
+            case COMMAND_ARG_UINT:
+            case COMMAND_ARG_NUMBER:
+                value.text = NextWord(text, pos);
+                if (!ParseNumber(value.text, arg.type, value.number))
+                {
+                    error = "argument " + std::to_string(values.size() + 1) + " must be a" + (arg.type == COMMAND_ARG_INT ? "n integer" : arg.type == COMMAND_ARG_UINT ? " positive integer" : " number");
+                    return false;
+                }
+                break;
+            case COMMAND_ARG_PLAYER:
+                value.text = NextWord(text, pos);
+                break;
+            case COMMAND_ARG_STRING:
+                if (text[pos] == '"')
+                {
+                    size_t begin = ++pos;
+                    while (text[pos] && text[pos] != '"')
+                        ++pos;
+                    if (text[pos] != '"')
+                    {
+                        error = "unterminated quoted string in argument " + std::to_string(values.size() + 1);
+                        return false;
+                    }
+                    value.text.assign(text + begin, pos - begin);
+                    ++pos;
+                }
+                else
+                    value.text = NextWord(text, pos);
+                break;
+            case COMMAND_ARG_LINK:
+            {
+                if (text[pos] == '|')
+                {
+                    // Links may contain spaces in the name, they always end with |h and an optional |r
+                    const char* end = std::strstr(text + pos, "]|h");
+                    if (!end)
+                    {
+                        error = "malformed link in argument " + std::to_string(values.size() + 1);
+                        return false;
+                    }
+                    size_t endPos = (end - text) + 3;
+                    if (text[endPos] == '|' && text[endPos + 1] == 'r')
+                        endPos += 2;
+
+                    std::string link(text + pos, endPos - pos);
+                    pos = endPos;
+                    if (!ParseLink(link, arg.linkType, value.number, value.text))
+                    {
+                        error = "argument " + std::to_string(values.size() + 1) + " must be a" + (arg.linkType.empty() ? " link" : "n " + arg.linkType + " link");
+                        return false;
+                    }
+                }
+                else
+                {
+                    // Plain ids are accepted in place of a link
+                    value.text = NextWord(text, pos);
+                    if (!ParseNumber(value.text, COMMAND_ARG_UINT, value.number))
+                    {
+                        error = "argument " + std::to_string(values.size() + 1) + " must be a link or an id";
+                        return false;
+                    }
+                    value.text = arg.linkType;
+                }
+                break;
+            }
+            case COMMAND_ARG_REST:
+            {
+                size_t end = std::strlen(text);
+                while (end > pos && IsSpace(text[end - 1]))
+                    --end;
+                value.text.assign(text + pos, end - pos);
+                pos = std::strlen(text);
+                break;
+            }
+        }
+
+        values.push_back(value);
+    }
+
+    while (text[pos] && IsSpace(text[pos]))
+        ++pos;
+
+    if (text[pos])
+    {
+        error = "too many arguments";
+        return false;
+    }
+
+    return true;
+}
+
+std::string ElunaCommandMgr::GetUsage(ElunaCommand const& command)
+{
+    static const char* const names[] = { "int", "uint", "number", "player", "string", "link", "text" };
+
+    std::ostringstream oss;
+    oss << command.path;
+    for (ElunaCommandArg const& arg : command.args)
+    {
+        std::string name = names[arg.type];
+        if (arg.type == COMMAND_ARG_LINK && !arg.linkType.empty())
+            name = arg.linkType;
+
+        oss << ' ' << (arg.optional ? '[' : '<') << name << (arg.optional ? ']' : '>');
+    }
+    return oss.str();
+}
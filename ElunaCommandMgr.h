@@ -0,0 +1,138 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_COMMAND_MGR_H
+#define _ELUNA_COMMAND_MGR_H
+
+#include "Common.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct lua_State;
+
+enum ElunaCommandArgType : uint8
+{
+    COMMAND_ARG_INT,      // signed integer
+    COMMAND_ARG_UINT,     // unsigned integer
+    COMMAND_ARG_NUMBER,   // any number
+    COMMAND_ARG_PLAYER,   // online player name
+    COMMAND_ARG_STRING,   // single word or "quoted string"
+    COMMAND_ARG_LINK,     // chat link (|Htype:id...|h[name]|h) or a plain id
+    COMMAND_ARG_REST      // everything left on the line
+};
+
+struct ElunaCommandArg
+{
+    ElunaCommandArgType type;
+    bool optional;
+    std::string linkType; // only used by COMMAND_ARG_LINK, empty accepts any link type
+};
+
+/*
+ * A single argument parsed from the command line according to its `ElunaCommandArg`.
+ * Player arguments are left as names; resolving them to objects is up to the caller.
+ */
+struct ElunaCommandValue
+{
+    ElunaCommandArgType type;
+    bool present;
+    double number;
+    std::string text;
+};
+
+struct ElunaCommand
+{
+    uint64 id;
+    uint32 security;
+    int functionReference;
+    std::string path;
+    std::vector<ElunaCommandArg> args;
+};
+
+/*
+ * Per-state registry of Lua commands.
+ *
+ * Command paths are split into lowercase words and stored in a prefix trie,
+ *   so dispatching a line only walks the words of that line instead of every
+ *   registered command. Words can be abbreviated as long as they are unambiguous,
+ *   the same way core commands can.
+ */
+class ElunaCommandMgr
+{
+public:
+    ElunaCommandMgr(lua_State* L);
+    ~ElunaCommandMgr();
+
+    ElunaCommandMgr(ElunaCommandMgr const&) = delete;
+    ElunaCommandMgr& operator=(ElunaCommandMgr const&) = delete;
+
+    /*
+     * Parses an argument specification such as "player uint link:item? rest?".
+     *
+     * Returns false and sets `error` if the specification is invalid.
+     */
+    static bool ParseArgSpec(const std::string& spec, std::vector<ElunaCommandArg>& args, std::string& error);
+
+    /*
+     * Registers `ref` as the handler of `path`, replacing any existing handler.
+     *
+     * Takes ownership of `ref`. Returns the id of the new command, or 0 if `path` is empty.
+     */
+    uint64 Insert(const std::string& path, uint32 security, std::vector<ElunaCommandArg>&& args, int ref);
+
+    /*
+     * Removes the command identified by `id`. Does nothing if it was already replaced or removed.
+     */
+    void Remove(uint64 id);
+
+    /*
+     * Removes all registered commands.
+     */
+    void Clear();
+
+    bool IsEmpty() const { return commandCount == 0; }
+
+    /*
+     * Finds the command matching the longest word prefix of `text`.
+     *
+     * On success `argsBegin` is set to the offset of the first argument in `text`.
+     */
+    ElunaCommand const* Find(const char* text, size_t& argsBegin) const;
+
+    /*
+     * Parses `text` into `values` according to the arguments of `command`.
+     *
+     * Returns false and sets `error` if a required argument is missing or malformed.
+     */
+    static bool ParseArgs(ElunaCommand const& command, const char* text, std::vector<ElunaCommandValue>& values, std::string& error);
+
+    /*
+     * Returns a human readable usage string for `command`, e.g. "event start <uint> [string]".
+     */
+    static std::string GetUsage(ElunaCommand const& command);
+
+private:
+    struct Node
+    {
+        std::unordered_map<std::string, std::unique_ptr<Node>> children;
+        std::unique_ptr<ElunaCommand> command;
+    };
+
+    Node const* FindChild(Node const* node, const std::string& word) const;
+    void Release(ElunaCommand& command);
+
+    lua_State* L;
+    Node root;
+    uint64 maxCommandID;
+    uint32 commandCount;
+    // id -> path, for removal through the cancel callback
+    std::unordered_map<uint64, std::string> id_lookup_table;
+};
+
+#endif
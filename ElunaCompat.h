@@ -43,4 +43,13 @@ extern "C"
     #define lua_pushunsigned(L, u) \
         lua_pushinteger(L, u)
 #endif
+
+/*
+ * Lua 5.3+ integers can hold 64-bit values, so with ELUNA_NATIVE_INT64 defined int64, uint64 and ObjectGuid
+ * are pushed as plain integers instead of userdata. This changes what scripts see: guids above 2^63 - 1 are
+ * negative and the ObjectGuid and int64 methods are gone, so it is opt-in. Ignored on other Lua versions.
+ */
+#if defined ELUNA_NATIVE_INT64 && !(LUA_VERSION_NUM > 502 && LUA_MAXINTEGER == LLONG_MAX)
+    #undef ELUNA_NATIVE_INT64
+#endif
 #endif
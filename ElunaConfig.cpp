@@ -38,15 +38,24 @@ void ElunaConfig::Initialize()
     SetConfig(CONFIG_ELUNA_ENABLE_UNSAFE, "Eluna.UseUnsafeMethods", true);
     SetConfig(CONFIG_ELUNA_ENABLE_DEPRECATED, "Eluna.UseDeprecatedMethods", true);
     SetConfig(CONFIG_ELUNA_ENABLE_RELOAD_COMMAND, "Eluna.ReloadCommand", true);
+    SetConfig(CONFIG_ELUNA_SCRIPT_PROFILING, "Eluna.ScriptProfiling", false);
+    SetConfig(CONFIG_ELUNA_SLOW_HANDLER_TRACEBACK, "Eluna.SlowHandlerTraceback", true);
 
     // Load strings
     SetConfig(CONFIG_ELUNA_SCRIPT_PATH, "Eluna.ScriptPath", "lua_scripts");
     SetConfig(CONFIG_ELUNA_ONLY_ON_MAPS, "Eluna.OnlyOnMaps", "");
     SetConfig(CONFIG_ELUNA_REQUIRE_PATH_EXTRA, "Eluna.RequirePaths", "");
     SetConfig(CONFIG_ELUNA_REQUIRE_CPATH_EXTRA, "Eluna.RequireCPaths", "");
+    SetConfig(CONFIG_ELUNA_CHROME_TRACE, "Eluna.ChromeTrace", "");
+    SetConfig(CONFIG_ELUNA_METRICS_FILE, "Eluna.MetricsFile", "");
 
     // Load ints
     SetConfig(CONFIG_ELUNA_RELOAD_SECURITY_LEVEL, "Eluna.ReloadSecurityLevel", 3);
+    SetConfig(CONFIG_ELUNA_SCRIPT_PROFILING_LOG_INTERVAL, "Eluna.ScriptProfilingLogInterval", 300);
+    SetConfig(CONFIG_ELUNA_SLOW_HANDLER_THRESHOLD, "Eluna.SlowHandlerThreshold", 0);
+    SetConfig(CONFIG_ELUNA_SLOW_HANDLER_REPORT_INTERVAL, "Eluna.SlowHandlerReportInterval", 60);
+    SetConfig(CONFIG_ELUNA_METRICS_SLOTS, "Eluna.MetricsSlots", 1024);
+    SetConfig(CONFIG_ELUNA_METRICS_INTERVAL, "Eluna.MetricsInterval", 1000);
 
     // Call extra functions
     TokenizeAllowedMaps();
@@ -17,6 +17,8 @@ enum ElunaConfigBoolValues
     CONFIG_ELUNA_ENABLE_UNSAFE,
     CONFIG_ELUNA_ENABLE_DEPRECATED,
     CONFIG_ELUNA_ENABLE_RELOAD_COMMAND,
+    CONFIG_ELUNA_SCRIPT_PROFILING,
+    CONFIG_ELUNA_SLOW_HANDLER_TRACEBACK,
     CONFIG_ELUNA_BOOL_COUNT
 };
 
@@ -26,12 +28,19 @@ enum ElunaConfigStringValues
     CONFIG_ELUNA_ONLY_ON_MAPS,
     CONFIG_ELUNA_REQUIRE_PATH_EXTRA,
     CONFIG_ELUNA_REQUIRE_CPATH_EXTRA,
+    CONFIG_ELUNA_CHROME_TRACE,
+    CONFIG_ELUNA_METRICS_FILE,
     CONFIG_ELUNA_STRING_COUNT
 };
 
 enum ElunaConfigUInt32Values
 {
     CONFIG_ELUNA_RELOAD_SECURITY_LEVEL,
+    CONFIG_ELUNA_SCRIPT_PROFILING_LOG_INTERVAL,
+    CONFIG_ELUNA_SLOW_HANDLER_THRESHOLD,
+    CONFIG_ELUNA_SLOW_HANDLER_REPORT_INTERVAL,
+    CONFIG_ELUNA_METRICS_SLOTS,
+    CONFIG_ELUNA_METRICS_INTERVAL,
     CONFIG_ELUNA_INT_COUNT
 };
 
@@ -56,6 +65,9 @@ public:
     bool UnsafeMethodsEnabled() { return GetConfig(CONFIG_ELUNA_ENABLE_UNSAFE); }
     bool DeprecatedMethodsEnabled() { return GetConfig(CONFIG_ELUNA_ENABLE_DEPRECATED); }
     bool IsReloadCommandEnabled() { return GetConfig(CONFIG_ELUNA_ENABLE_RELOAD_COMMAND); }
+    bool IsScriptProfilingEnabled() { return GetConfig(CONFIG_ELUNA_SCRIPT_PROFILING); }
+    bool IsSlowHandlerDetectionEnabled() { return GetConfig(CONFIG_ELUNA_SLOW_HANDLER_THRESHOLD) != 0; }
+    bool IsMetricsExportEnabled() { return !GetConfig(CONFIG_ELUNA_METRICS_FILE).empty(); }
     AccountTypes GetReloadSecurityLevel() { return static_cast<AccountTypes>(GetConfig(CONFIG_ELUNA_RELOAD_SECURITY_LEVEL)); }
     bool ShouldMapLoadEluna(uint32 mapId);
 
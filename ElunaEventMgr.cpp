@@ -46,7 +46,7 @@ void ElunaEventProcessor::Update(uint32 diff)
 
             // Call the timed event
             if (!obj || (obj && obj->IsInWorld()))
-                mgr->E->OnTimedEvent(luaEvent->funcRef, delay, luaEvent->repeats ? luaEvent->repeats-- : luaEvent->repeats, obj);
+                mgr->E->OnTimedEvent(luaEvent->funcRef, delay, luaEvent->repeats ? luaEvent->repeats-- : luaEvent->repeats, obj, luaEvent->scriptId);
 
             if (!remove)
                 continue;
@@ -122,7 +122,7 @@ void ElunaEventProcessor::AddEvent(LuaEvent* luaEvent)
 
 void ElunaEventProcessor::AddEvent(int funcRef, uint32 min, uint32 max, uint32 repeats)
 {
-    AddEvent(new LuaEvent(funcRef, min, max, repeats));
+    AddEvent(new LuaEvent(funcRef, min, max, repeats, mgr->E->GetActiveScriptId()));
 }
 
 void ElunaEventProcessor::RemoveEvent(LuaEvent* luaEvent)
@@ -131,7 +131,7 @@ void ElunaEventProcessor::RemoveEvent(LuaEvent* luaEvent)
     if (luaEvent->state != LUAEVENT_STATE_ERASE && mgr->E->HasLuaState())
     {
         // Free lua function ref
-        luaL_unref(mgr->E->L, LUA_REGISTRYINDEX, luaEvent->funcRef);
+        ELUNA_UNREF(mgr->E->L, luaEvent->funcRef);
     }
     delete luaEvent;
 }
@@ -217,6 +217,27 @@ void EventMgr::SetEventState(int eventId, LuaEventState state)
         processor->SetState(eventId, state);
 }
 
+void EventMgr::UntrackRefs(ElunaRefTracker* tracker)
+{
+    for (auto* processor : processors)
+    {
+        for (auto& [time, event] : processor->eventList)
+            tracker->Remove(event->funcRef);
+
+        for (ElunaEventProcessor::DeferredOp const& op : processor->deferredOps)
+            if (op.type == DeferredOpType::AddEvent)
+                tracker->Remove(op.event->funcRef);
+    }
+}
+
+size_t EventMgr::GetEventCount() const
+{
+    size_t count = 0;
+    for (auto* processor : processors)
+        count += processor->eventList.size();
+    return count;
+}
+
 ElunaEventProcessor* EventMgr::GetGlobalProcessor(GlobalEventSpace space)
 {
     auto it = globalProcessors.find(space);
@@ -30,6 +30,7 @@
 class Eluna;
 class EventMgr;
 class ElunaEventProcessor;
+class ElunaRefTracker;
 class WorldObject;
 
 enum LuaEventState : uint8
@@ -54,7 +55,7 @@ enum GlobalEventSpace : uint8
 
 struct LuaEvent
 {
-    LuaEvent(int _funcRef, uint32 _min, uint32 _max, uint32 _repeats) : min(_min), max(_max), delay(0), repeats(_repeats), funcRef(_funcRef), state(LUAEVENT_STATE_RUN) { }
+    LuaEvent(int _funcRef, uint32 _min, uint32 _max, uint32 _repeats, uint32 _scriptId) : min(_min), max(_max), delay(0), repeats(_repeats), funcRef(_funcRef), scriptId(_scriptId), state(LUAEVENT_STATE_RUN) { }
 
     void SetState(LuaEventState _state)
     {
@@ -72,6 +73,7 @@ struct LuaEvent
     uint32 delay; // The currently used waiting time
     uint32 repeats; // Amount of repeats to make, 0 for infinite
     int funcRef;    // Lua function reference ID, also used as event ID
+    uint32 scriptId; // Script file that created the event, see ElunaScriptProfiler
     LuaEventState state;    // State for next call
 };
 
@@ -144,6 +146,12 @@ public:
     void SetAllEventStates(LuaEventState state);
     void SetEventState(int eventId, LuaEventState state);
 
+    // Stops tracking the function references of all events, for when they are released along with the state
+    void UntrackRefs(ElunaRefTracker* tracker);
+
+    // Number of timed events waiting to run in all processors
+    size_t GetEventCount() const;
+
     // Global (per state) processors
     ElunaEventProcessor* GetGlobalProcessor(GlobalEventSpace space);
 
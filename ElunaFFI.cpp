@@ -0,0 +1,253 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaFFI.h"
+#include "LuaEngine.h"
+#include "ElunaIncludes.h"
+#include "ElunaTemplate.h"
+
+#include <cstring>
+#include <limits>
+
+#if defined LUAJIT_VERSION
+namespace
+{
+    const double INVALID = std::numeric_limits<double>::quiet_NaN();
+
+    template<typename T>
+    T* GetIfType(Eluna* E, ElunaObject* obj)
+    {
+        if (obj->GetTypeName() != ElunaTemplate<T>::tname)
+            return nullptr;
+        return static_cast<T*>(static_cast<ElunaObjectImpl<T>*>(obj)->GetObjIfValid(E));
+    }
+
+    Unit* GetUnit(Eluna* E, void* object)
+    {
+        if (!E || !object)
+            return nullptr;
+
+        ElunaObject* obj = static_cast<ElunaObject*>(object);
+        if (Player* player = GetIfType<Player>(E, obj))
+            return player;
+        return GetIfType<Creature>(E, obj);
+    }
+
+    WorldObject* GetWorldObject(Eluna* E, void* object)
+    {
+        if (Unit* unit = GetUnit(E, object))
+            return unit;
+        if (!E || !object)
+            return nullptr;
+
+        ElunaObject* obj = static_cast<ElunaObject*>(object);
+        if (GameObject* go = GetIfType<GameObject>(E, obj))
+            return go;
+        return GetIfType<Corpse>(E, obj);
+    }
+
+    double GetEntry(Eluna* E, void* object)
+    {
+        WorldObject* obj = GetWorldObject(E, object);
+        return obj ? double(obj->GetEntry()) : INVALID;
+    }
+
+    double GetMapId(Eluna* E, void* object)
+    {
+        WorldObject* obj = GetWorldObject(E, object);
+        return obj ? double(obj->GetMapId()) : INVALID;
+    }
+
+    double GetInstanceId(Eluna* E, void* object)
+    {
+        WorldObject* obj = GetWorldObject(E, object);
+        return obj ? double(obj->GetInstanceId()) : INVALID;
+    }
+
+    double GetX(Eluna* E, void* object)
+    {
+        WorldObject* obj = GetWorldObject(E, object);
+        return obj ? double(obj->GetPositionX()) : INVALID;
+    }
+
+    double GetY(Eluna* E, void* object)
+    {
+        WorldObject* obj = GetWorldObject(E, object);
+        return obj ? double(obj->GetPositionY()) : INVALID;
+    }
+
+    double GetZ(Eluna* E, void* object)
+    {
+        WorldObject* obj = GetWorldObject(E, object);
+        return obj ? double(obj->GetPositionZ()) : INVALID;
+    }
+
+    double GetO(Eluna* E, void* object)
+    {
+        WorldObject* obj = GetWorldObject(E, object);
+        return obj ? double(obj->GetOrientation()) : INVALID;
+    }
+
+    double GetHealth(Eluna* E, void* object)
+    {
+        Unit* unit = GetUnit(E, object);
+        return unit ? double(unit->GetHealth()) : INVALID;
+    }
+
+    double GetMaxHealth(Eluna* E, void* object)
+    {
+        Unit* unit = GetUnit(E, object);
+        return unit ? double(unit->GetMaxHealth()) : INVALID;
+    }
+
+    double GetLevel(Eluna* E, void* object)
+    {
+        Unit* unit = GetUnit(E, object);
+        if (!unit)
+            return INVALID;
+#if defined ELUNA_MANGOS
+        return double(unit->getLevel());
+#else
+        return double(unit->GetLevel());
+#endif
+    }
+
+    double IsAlive(Eluna* E, void* object)
+    {
+        Unit* unit = GetUnit(E, object);
+        return unit ? double(unit->IsAlive()) : INVALID;
+    }
+
+    // Pushes the metatable of the userdata of T, nil if the type is not registered
+    template<typename T>
+    void PushMetatable(lua_State* L)
+    {
+        if (!ElunaTemplate<T>::tname)
+        {
+            lua_pushnil(L);
+            return;
+        }
+
+        lua_pushstring(L, ElunaTemplate<T>::tname);
+        lua_rawget(L, LUA_REGISTRYINDEX);
+    }
+
+    const ElunaFFIApi api =
+    {
+        &GetEntry,
+        &GetMapId,
+        &GetInstanceId,
+        &GetX,
+        &GetY,
+        &GetZ,
+        &GetO,
+        &GetHealth,
+        &GetMaxHealth,
+        &GetLevel,
+        &IsAlive
+    };
+
+    // Builds the ElunaFFI table from the function pointers, called with the api, the state and the metatables
+    //   of the types the getters accept as arguments
+    const char* const ffiLoader = R"lua(
+local api, state, Player, Creature, GameObject, Corpse = ...
+local ffi = require("ffi")
+ffi.cdef[[
+typedef double (*ElunaFFIGetter)(void* E, void* object);
+typedef struct
+{
+    ElunaFFIGetter GetEntry, GetMapId, GetInstanceId, GetX, GetY, GetZ, GetO, GetHealth, GetMaxHealth, GetLevel, IsAlive;
+} ElunaFFIApi;
+]]
+api = ffi.cast("const ElunaFFIApi*", api)
+state = ffi.cast("void*", state)
+
+-- Only Eluna userdata may reach the getters, anything else would be read as an Eluna object.
+--   The metatable of an object is its type, so it is checked against the metatables the getter accepts
+local function Accept(...)
+    local accepted = {}
+    for i = 1, select("#", ...) do
+        local metatable = select(i, ...)
+        if metatable then
+            accepted[metatable] = true
+        end
+    end
+    return accepted
+end
+local units = Accept(Player, Creature)
+local worldObjects = Accept(Player, Creature, GameObject, Corpse)
+
+local error, getmetatable, type = error, getmetatable, type
+local ElunaFFI = {}
+local function MakeGetter(name, accepted, boolean)
+    local getter = api[name]
+    if boolean then
+        ElunaFFI[name] = function(obj)
+            if type(obj) ~= "userdata" or not accepted[getmetatable(obj)] then
+                error("ElunaFFI." .. name .. ": invalid object", 2)
+            end
+            local value = getter(state, obj)
+            if value ~= value then
+                error("ElunaFFI." .. name .. ": invalid object", 2)
+            end
+            return value ~= 0
+        end
+    else
+        ElunaFFI[name] = function(obj)
+            if type(obj) ~= "userdata" or not accepted[getmetatable(obj)] then
+                error("ElunaFFI." .. name .. ": invalid object", 2)
+            end
+            local value = getter(state, obj)
+            if value ~= value then
+                error("ElunaFFI." .. name .. ": invalid object", 2)
+            end
+            return value
+        end
+    end
+end
+
+for _, name in ipairs({ "GetEntry", "GetMapId", "GetInstanceId", "GetX", "GetY", "GetZ", "GetO" }) do
+    MakeGetter(name, worldObjects, false)
+end
+for _, name in ipairs({ "GetHealth", "GetMaxHealth", "GetLevel" }) do
+    MakeGetter(name, units, false)
+end
+MakeGetter("IsAlive", units, true)
+
+return ElunaFFI
+)lua";
+}
+#endif
+
+void ElunaFFI::Register(Eluna* E)
+{
+#if defined LUAJIT_VERSION
+    lua_State* L = E->L;
+    if (luaL_loadbuffer(L, ffiLoader, strlen(ffiLoader), "=ElunaFFI") != 0)
+    {
+        ELUNA_LOG_ERROR("[Eluna]: Could not load ElunaFFI: %s", lua_tostring(L, -1));
+        lua_pop(L, 1);
+        return;
+    }
+
+    lua_pushlightuserdata(L, const_cast<ElunaFFIApi*>(&api));
+    lua_pushlightuserdata(L, E);
+    PushMetatable<Player>(L);
+    PushMetatable<Creature>(L);
+    PushMetatable<GameObject>(L);
+    PushMetatable<Corpse>(L);
+    if (lua_pcall(L, 6, 1, 0) != 0)
+    {
+        ELUNA_LOG_ERROR("[Eluna]: Could not create ElunaFFI: %s", lua_tostring(L, -1));
+        lua_pop(L, 1);
+        return;
+    }
+
+    lua_setglobal(L, "ElunaFFI");
+#else
+    (void)E;
+#endif
+}
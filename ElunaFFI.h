@@ -0,0 +1,53 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_FFI_H
+#define _ELUNA_FFI_H
+
+class Eluna;
+
+/*
+ * Getters callable through the LuaJIT FFI.
+ *
+ * Method calls go through a lua_CFunction, which the LuaJIT compiler cannot trace through.
+ *   These getters are plain C functions reached through a table of function pointers,
+ *   so a loop that only uses them can stay compiled. They are exposed to scripts as the
+ *   global ElunaFFI table, which only exists when Eluna is built against LuaJIT.
+ *
+ * Every getter takes the Eluna state and the object userdata. The FFI passes any value as a pointer,
+ *   so the Lua side only calls a getter after checking the metatable of the value is one of the
+ *   registered types the getter accepts. The getters then check the object is still valid like a
+ *   method call does and return NaN if it is not, which the Lua side turns into an error.
+ */
+extern "C"
+{
+    typedef double (*ElunaFFIGetter)(Eluna* E, void* object);
+
+    struct ElunaFFIApi
+    {
+        ElunaFFIGetter GetEntry;
+        ElunaFFIGetter GetMapId;
+        ElunaFFIGetter GetInstanceId;
+        ElunaFFIGetter GetX;
+        ElunaFFIGetter GetY;
+        ElunaFFIGetter GetZ;
+        ElunaFFIGetter GetO;
+        ElunaFFIGetter GetHealth;
+        ElunaFFIGetter GetMaxHealth;
+        ElunaFFIGetter GetLevel;
+        ElunaFFIGetter IsAlive;
+    };
+}
+
+namespace ElunaFFI
+{
+    /*
+     * Creates the ElunaFFI global table. Does nothing unless built against LuaJIT.
+     */
+    void Register(Eluna* E);
+}
+
+#endif
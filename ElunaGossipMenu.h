@@ -0,0 +1,70 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_GOSSIP_MENU_H
+#define _ELUNA_GOSSIP_MENU_H
+
+#include "Common.h"
+
+#include <string>
+#include <vector>
+
+/*
+ * Requirements a player has to meet to see a gossip item.
+ * A value of 0 (or -1 for team) means the requirement is not checked.
+ */
+struct ElunaGossipCondition
+{
+    uint32 minLevel = 0;
+    uint32 maxLevel = 0;
+    uint32 classMask = 0;
+    uint32 raceMask = 0;
+    int32 team = -1;
+    uint32 security = 0;
+    uint32 questRewarded = 0;
+    uint32 questNotRewarded = 0;
+    uint32 item = 0;
+    uint32 money = 0;
+
+    bool IsEmpty() const
+    {
+        return !minLevel && !maxLevel && !classMask && !raceMask && team < 0 && !security &&
+            !questRewarded && !questNotRewarded && !item && !money;
+    }
+};
+
+struct ElunaGossipMenuItem
+{
+    uint32 icon;
+    std::string text;
+    uint32 sender;
+    uint32 intid;
+    bool code;
+    std::string popup;
+    uint32 money;
+    bool conditional;
+    ElunaGossipCondition condition;
+};
+
+/*
+ * A gossip menu built once from Lua and sent to players natively.
+ *
+ * The items are stored as they are passed to the core's gossip menu,
+ *   so sending the menu does not call back into Lua.
+ */
+class ElunaGossipMenu
+{
+public:
+    ElunaGossipMenu(uint32 npcText, uint32 menuId) : npcText(npcText), menuId(menuId)
+    {
+    }
+
+    uint32 npcText;
+    uint32 menuId;
+    std::vector<ElunaGossipMenuItem> items;
+};
+
+#endif
@@ -0,0 +1,357 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaHeapCensus.h"
+#include "ElunaCompat.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    // Estimated sizes of objects on a 64-bit build
+    const uint64 STRING_SIZE = 24;
+    const uint64 TABLE_SIZE = 56;
+    const uint64 ARRAY_ENTRY_SIZE = 16;
+    const uint64 HASH_ENTRY_SIZE = 32;
+    const uint64 CLOSURE_SIZE = 32;
+    const uint64 UPVALUE_SIZE = 16;
+    const uint64 USERDATA_SIZE = 40;
+    const uint64 THREAD_SIZE = 200;
+
+    // Longest part of a string key written to a path
+    const size_t MAX_KEY_LENGTH = 32;
+
+    const uint32 ROOT = uint32(-1);
+
+    class Walker
+    {
+    public:
+        Walker(lua_State* L, uint32 budget, std::map<std::string, ElunaHeapCensus::TypeStats>& types) :
+            L(L), budget(budget), examined(0), exhausted(false), queue(0), types(types)
+        {
+        }
+
+        struct Node
+        {
+            uint32 parent;
+            std::string label;
+            bool table;
+            uint64 entries;
+            uint64 bytes;
+        };
+
+        /*
+         * Walks everything reachable from the globals and the registry, returns false if the budget ran out.
+         */
+        bool Run()
+        {
+            FindTypeNames();
+
+            // Objects waiting to be walked are kept alive in a queue table, which is left out of the census
+            lua_newtable(L);
+            queue = lua_gettop(L);
+            visited.insert(lua_topointer(L, queue));
+
+            lua_pushglobaltable(L);
+            if (Count(-1))
+                Enqueue(-1, ROOT, "_G");
+            lua_pop(L, 1);
+
+            lua_pushvalue(L, LUA_REGISTRYINDEX);
+            if (Count(-1))
+                Enqueue(-1, ROOT, "registry");
+            lua_pop(L, 1);
+
+            uint32 next = 0;
+            for (; next < nodes.size() && !exhausted; ++next)
+            {
+                lua_rawgeti(L, queue, next + 1);
+                Expand(next);
+                lua_pop(L, 1);
+
+                lua_pushnil(L);
+                lua_rawseti(L, queue, next + 1);
+            }
+
+            lua_pop(L, 1);
+            return next == nodes.size() && !exhausted;
+        }
+
+        uint32 GetExamined() const { return examined; }
+        std::vector<Node> const& GetNodes() const { return nodes; }
+
+        std::string GetPath(uint32 id) const
+        {
+            std::vector<std::string const*> labels;
+            for (; id != ROOT; id = nodes[id].parent)
+                labels.push_back(&nodes[id].label);
+
+            std::string path;
+            for (auto itr = labels.rbegin(); itr != labels.rend(); ++itr)
+                path += **itr;
+            return path;
+        }
+
+    private:
+        // Maps the metatables of Eluna types, which the registry holds by type name, to their name
+        void FindTypeNames()
+        {
+            lua_pushnil(L);
+            while (lua_next(L, LUA_REGISTRYINDEX))
+            {
+                if (lua_type(L, -2) == LUA_TSTRING && lua_istable(L, -1))
+                    typeNames.emplace(lua_topointer(L, -1), lua_tostring(L, -2));
+                lua_pop(L, 1);
+            }
+        }
+
+        bool Examine()
+        {
+            if (examined >= budget)
+            {
+                exhausted = true;
+                return false;
+            }
+            ++examined;
+            return true;
+        }
+
+        void Add(std::string const& type, uint64 bytes)
+        {
+            ElunaHeapCensus::TypeStats& stats = types[type];
+            ++stats.count;
+            stats.bytes += bytes;
+        }
+
+        /*
+         * Counts the value at `index` if it was not seen before, returns true if it is an object that has to be walked.
+         */
+        bool Count(int index)
+        {
+            if (!Examine())
+                return false;
+
+            switch (lua_type(L, index))
+            {
+                case LUA_TSTRING:
+                {
+                    // Strings are interned or immutable, so their contents identify them
+                    size_t length;
+                    const char* str = lua_tolstring(L, index, &length);
+                    if (visited.insert(str).second)
+                        Add("string", STRING_SIZE + length + 1);
+                    return false;
+                }
+                case LUA_TTABLE:
+                case LUA_TFUNCTION:
+                case LUA_TUSERDATA:
+                case LUA_TTHREAD:
+                    return visited.insert(lua_topointer(L, index)).second;
+                default:
+                    return false;
+            }
+        }
+
+        void Enqueue(int index, uint32 parent, std::string const& label)
+        {
+            index = lua_absindex(L, index);
+            nodes.push_back({ parent, label, false, 0, 0 });
+            lua_pushvalue(L, index);
+            lua_rawseti(L, queue, int(nodes.size()));
+        }
+
+        static bool IsIdentifier(const char* str, size_t length)
+        {
+            if (!length || length > MAX_KEY_LENGTH || (!isalpha(uint8(str[0])) && str[0] != '_'))
+                return false;
+            for (size_t i = 1; i < length; ++i)
+                if (!isalnum(uint8(str[i])) && str[i] != '_')
+                    return false;
+            return true;
+        }
+
+        std::string KeyLabel(int key)
+        {
+            switch (lua_type(L, key))
+            {
+                case LUA_TSTRING:
+                {
+                    size_t length;
+                    const char* str = lua_tolstring(L, key, &length);
+                    if (IsIdentifier(str, length))
+                        return std::string(".") + str;
+                    return "[\"" + std::string(str, std::min(length, MAX_KEY_LENGTH)) + (length > MAX_KEY_LENGTH ? "...\"]" : "\"]");
+                }
+                case LUA_TNUMBER:
+                {
+                    // Converts a copy, converting the key itself would break lua_next
+                    lua_pushvalue(L, key);
+                    std::string label = std::string("[") + lua_tostring(L, -1) + "]";
+                    lua_pop(L, 1);
+                    return label;
+                }
+                case LUA_TBOOLEAN:
+                    return lua_toboolean(L, key) ? "[true]" : "[false]";
+                default:
+                    return std::string("[") + lua_typename(L, lua_type(L, key)) + "]";
+            }
+        }
+
+        void ExpandMetatable(uint32 id, int object)
+        {
+            if (!lua_getmetatable(L, object))
+                return;
+            if (Count(-1))
+                Enqueue(-1, id, "[metatable]");
+            lua_pop(L, 1);
+        }
+
+        void Expand(uint32 id)
+        {
+            int object = lua_gettop(L);
+            switch (lua_type(L, object))
+            {
+                case LUA_TTABLE:
+                    ExpandTable(id, object);
+                    break;
+                case LUA_TFUNCTION:
+                    ExpandFunction(id, object);
+                    break;
+                case LUA_TUSERDATA:
+                    ExpandUserdata(id, object);
+                    break;
+                case LUA_TTHREAD:
+                    Add("thread", THREAD_SIZE);
+                    break;
+            }
+        }
+
+        void ExpandTable(uint32 id, int object)
+        {
+            ExpandMetatable(id, object);
+
+            lua_Number arraySize = lua_Number(lua_rawlen(L, object));
+            uint64 entries = 0;
+            uint64 arrayEntries = 0;
+
+            if (!exhausted)
+                lua_pushnil(L);
+            while (!exhausted && lua_next(L, object))
+            {
+                int key = lua_gettop(L) - 1;
+                ++entries;
+                if (lua_type(L, key) == LUA_TNUMBER)
+                {
+                    lua_Number n = lua_tonumber(L, key);
+                    if (n >= 1 && n <= arraySize && n == std::floor(n))
+                        ++arrayEntries;
+                }
+
+                if (Count(key))
+                    Enqueue(key, id, "[key]");
+                if (Count(-1))
+                    Enqueue(-1, id, KeyLabel(key));
+                lua_pop(L, 1);
+
+                // The key lua_next would continue from is left over once the budget runs out
+                if (exhausted)
+                    lua_pop(L, 1);
+            }
+
+            Node& node = nodes[id];
+            node.table = true;
+            node.entries = entries;
+            node.bytes = TABLE_SIZE + arrayEntries * ARRAY_ENTRY_SIZE + (entries - arrayEntries) * HASH_ENTRY_SIZE;
+            Add("table", node.bytes);
+        }
+
+        void ExpandFunction(uint32 id, int object)
+        {
+            uint32 upvalues = 0;
+            while (const char* name = lua_getupvalue(L, object, upvalues + 1))
+            {
+                ++upvalues;
+                if (Count(-1))
+                    Enqueue(-1, id, *name ? std::string("[upvalue ") + name + "]" : "[upvalue " + std::to_string(upvalues) + "]");
+                lua_pop(L, 1);
+
+                if (exhausted)
+                    break;
+            }
+
+            Add(lua_iscfunction(L, object) ? "cfunction" : "function", CLOSURE_SIZE + upvalues * UPVALUE_SIZE);
+        }
+
+        void ExpandUserdata(uint32 id, int object)
+        {
+            const char* type = "userdata";
+            if (lua_getmetatable(L, object))
+            {
+                auto itr = typeNames.find(lua_topointer(L, -1));
+                if (itr != typeNames.end())
+                    type = itr->second.c_str();
+
+                if (Count(-1))
+                    Enqueue(-1, id, "[metatable]");
+                lua_pop(L, 1);
+            }
+
+            Add(type, USERDATA_SIZE + lua_rawlen(L, object));
+        }
+
+        lua_State* L;
+        uint32 budget;
+        uint32 examined;
+        bool exhausted;
+        int queue;
+        std::map<std::string, ElunaHeapCensus::TypeStats>& types;
+        std::unordered_map<const void*, std::string> typeNames;
+        std::unordered_set<const void*> visited;
+        std::vector<Node> nodes;
+    };
+}
+
+ElunaHeapCensus::ElunaHeapCensus(lua_State* L, uint32 budget, uint32 largestTables) :
+    complete(false), examined(0), heapBytes(0)
+{
+    heapBytes = uint64(lua_gc(L, LUA_GCCOUNT, 0)) * 1024 + uint64(lua_gc(L, LUA_GCCOUNTB, 0));
+
+    // A collection during the walk could clear weak tables that are being walked
+#ifdef LUA_GCISRUNNING
+    bool collecting = lua_gc(L, LUA_GCISRUNNING, 0) != 0;
+#else
+    bool collecting = true;
+#endif
+    lua_gc(L, LUA_GCSTOP, 0);
+
+    {
+        lua_checkstack(L, 8);
+
+        Walker walker(L, budget, types);
+        complete = walker.Run();
+        examined = walker.GetExamined();
+
+        std::vector<Walker::Node> const& nodes = walker.GetNodes();
+        std::vector<uint32> tables;
+        for (uint32 id = 0; id < nodes.size(); ++id)
+            if (nodes[id].table)
+                tables.push_back(id);
+
+        size_t count = std::min<size_t>(largestTables, tables.size());
+        std::partial_sort(tables.begin(), tables.begin() + count, tables.end(),
+            [&nodes](uint32 a, uint32 b) { return nodes[a].bytes > nodes[b].bytes; });
+
+        for (size_t i = 0; i < count; ++i)
+            this->largestTables.push_back({ walker.GetPath(tables[i]), nodes[tables[i]].entries, nodes[tables[i]].bytes });
+    }
+
+    if (collecting)
+        lua_gc(L, LUA_GCRESTART, 0);
+}
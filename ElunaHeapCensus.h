@@ -0,0 +1,65 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_HEAP_CENSUS_H
+#define _ELUNA_HEAP_CENSUS_H
+
+#include "Common.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+struct lua_State;
+
+/*
+ * Counts the objects reachable from the globals and the registry of a state by type.
+ *
+ * Objects are walked breadth first, so the path kept for each table is the shortest one from a root.
+ *   Eluna userdata are counted under their type name, like "Player". Lua does not expose object sizes,
+ *   so bytes are estimates of the object headers and their contents, while the heap size is the real one.
+ *   Thread stacks and function prototypes are not walked.
+ *
+ * The walk stops after examining `budget` values, so it can be run on a live server.
+ *   The garbage collector is stopped while it runs.
+ */
+class ElunaHeapCensus
+{
+public:
+    struct TypeStats
+    {
+        uint64 count;
+        uint64 bytes;
+    };
+
+    struct Table
+    {
+        std::string path;
+        uint64 entries;
+        uint64 bytes;
+    };
+
+    ElunaHeapCensus(lua_State* L, uint32 budget, uint32 largestTables);
+
+    // False if the walk ran out of budget before reaching every object
+    bool IsComplete() const { return complete; }
+    uint32 GetExamined() const { return examined; }
+    uint64 GetHeapBytes() const { return heapBytes; }
+
+    std::map<std::string, TypeStats> const& GetTypes() const { return types; }
+
+    // Tables with the most estimated bytes, largest first
+    std::vector<Table> const& GetLargestTables() const { return largestTables; }
+
+private:
+    bool complete;
+    uint32 examined;
+    uint64 heapBytes;
+    std::map<std::string, TypeStats> types;
+    std::vector<Table> largestTables;
+};
+
+#endif
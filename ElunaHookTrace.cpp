@@ -0,0 +1,610 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "Hooks.h"
+#include "HookHelpers.h"
+#include "ElunaHookTrace.h"
+#include "ElunaIncludes.h"
+#include "ElunaTemplate.h"
+
+#include <cstring>
+#include <unordered_map>
+
+namespace
+{
+    const char TRACE_MAGIC[4] = { 'E', 'L', 'H', 'T' };
+    const uint32 TRACE_VERSION = 2;
+    const size_t FLUSH_SIZE = 64 * 1024;
+}
+
+class ElunaHookTrace::Reader
+{
+public:
+    explicit Reader(std::vector<uint8> const& data) : data(data), pos(0) { }
+
+    bool AtEnd() const { return pos >= data.size(); }
+
+    template<typename T>
+    bool Read(T& value)
+    {
+        if (data.size() - pos < sizeof(T))
+            return false;
+        memcpy(&value, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(std::string& value, size_t len)
+    {
+        if (data.size() - pos < len)
+            return false;
+        value.assign(reinterpret_cast<const char*>(data.data() + pos), len);
+        pos += len;
+        return true;
+    }
+
+    bool ReadValue(Value& value)
+    {
+        uint8 tag;
+        if (!Read(tag))
+            return false;
+
+        value.tag = static_cast<ValueTag>(tag);
+        switch (value.tag)
+        {
+            case VALUE_NIL:
+            case VALUE_FALSE:
+            case VALUE_TRUE:
+                return true;
+            case VALUE_NUMBER:
+                return Read(value.number);
+            case VALUE_INTEGER:
+            case VALUE_INT64:
+            case VALUE_GUID:
+                return Read(value.integer);
+            case VALUE_STRING:
+            {
+                uint32 len;
+                return Read(len) && ReadString(value.string, len);
+            }
+            case VALUE_OBJECT:
+            {
+                uint8 len;
+                return Read(len) && ReadString(value.string, len) && Read(value.integer);
+            }
+            case VALUE_OTHER:
+            {
+                uint8 type;
+                if (!Read(type))
+                    return false;
+                value.integer = type;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::vector<uint8> const& data;
+    size_t pos;
+};
+
+bool ElunaHookTrace::Value::operator==(Value const& other) const
+{
+    if (tag != other.tag)
+        return false;
+
+    switch (tag)
+    {
+        case VALUE_NUMBER:
+            return number == other.number;
+        case VALUE_STRING:
+            return string == other.string;
+        case VALUE_OBJECT:
+            return string == other.string && integer == other.integer;
+        case VALUE_INTEGER:
+        case VALUE_INT64:
+        case VALUE_GUID:
+        case VALUE_OTHER:
+            return integer == other.integer;
+        default:
+            return true;
+    }
+}
+
+ElunaHookTrace::ElunaHookTrace(Eluna* E, std::string const& path, uint64 maxBytes) :
+    E(E), file(fopen(path.c_str(), "wb")), maxBytes(maxBytes), written(0), startTime(ElunaUtil::GetCurrTimeUs()), nextHook(1), full(false)
+{
+    if (!file)
+    {
+        ELUNA_LOG_ERROR("[Eluna]: Could not open hook trace file `%s`", path.c_str());
+        return;
+    }
+
+    buffer.reserve(FLUSH_SIZE * 2);
+    buffer.insert(buffer.end(), TRACE_MAGIC, TRACE_MAGIC + sizeof(TRACE_MAGIC));
+    Write(TRACE_VERSION);
+}
+
+ElunaHookTrace::~ElunaHookTrace()
+{
+    if (!file)
+        return;
+
+    Flush();
+    fclose(file);
+}
+
+ElunaHookTrace::Value ElunaHookTrace::ToValue(Eluna* E, int index)
+{
+    lua_State* L = E->L;
+    Value value = { VALUE_NIL, 0.0, 0, std::string() };
+
+    switch (lua_type(L, index))
+    {
+        case LUA_TNIL:
+        case LUA_TNONE:
+            break;
+        case LUA_TBOOLEAN:
+            value.tag = lua_toboolean(L, index) ? VALUE_TRUE : VALUE_FALSE;
+            break;
+        case LUA_TNUMBER:
+#if LUA_VERSION_NUM > 502
+            if (lua_isinteger(L, index))
+            {
+                value.tag = VALUE_INTEGER;
+                value.integer = lua_tointeger(L, index);
+                break;
+            }
+#endif
+            value.tag = VALUE_NUMBER;
+            value.number = lua_tonumber(L, index);
+            break;
+        case LUA_TSTRING:
+        {
+            size_t len;
+            const char* str = lua_tolstring(L, index, &len);
+            value.tag = VALUE_STRING;
+            value.string.assign(str, len);
+            break;
+        }
+        case LUA_TUSERDATA:
+            if (Object* obj = E->CHECKOBJ<Object>(index, false))
+            {
+                value.tag = VALUE_OBJECT;
+                value.string = E->CHECKOBJ<ElunaObject>(index, false)->GetTypeName();
+                value.integer = int64(obj->GET_GUID().GetRawValue());
+                break;
+            }
+#if !defined ELUNA_NATIVE_INT64
+            if (E->CHECKTYPE(index, ElunaTemplate<ObjectGuid>::tname, false))
+            {
+                value.tag = VALUE_GUID;
+                value.integer = int64(E->CHECKVAL<ObjectGuid>(index).GetRawValue());
+                break;
+            }
+            if (E->CHECKTYPE(index, ElunaTemplate<long long>::tname, false) || E->CHECKTYPE(index, ElunaTemplate<unsigned long long>::tname, false))
+            {
+                value.tag = VALUE_INT64;
+                value.integer = E->CHECKVAL<long long>(index);
+                break;
+            }
+#endif
+            value.tag = VALUE_OTHER;
+            value.integer = LUA_TUSERDATA;
+            break;
+        default:
+            value.tag = VALUE_OTHER;
+            value.integer = lua_type(L, index);
+            break;
+    }
+    return value;
+}
+
+void ElunaHookTrace::PushValue(Eluna* E, ObjectFactory const& objects, Value const& value)
+{
+    switch (value.tag)
+    {
+        case VALUE_FALSE:
+        case VALUE_TRUE:
+            E->Push(value.tag == VALUE_TRUE);
+            break;
+        case VALUE_NUMBER:
+            E->Push(value.number);
+            break;
+        case VALUE_INTEGER:
+            lua_pushinteger(E->L, lua_Integer(value.integer));
+            break;
+        case VALUE_INT64:
+            E->Push(static_cast<long long>(value.integer));
+            break;
+        case VALUE_STRING:
+            E->Push(value.string);
+            break;
+        case VALUE_OBJECT:
+        {
+            Object* obj = value.integer && objects ? objects(value.string, uint64(value.integer)) : nullptr;
+            if (obj)
+                E->Push(obj);
+            else
+                E->Push();
+            break;
+        }
+        case VALUE_GUID:
+            E->Push(ObjectGuid(uint64(value.integer)));
+            break;
+        default:
+            E->Push();
+            break;
+    }
+}
+
+void ElunaHookTrace::WriteValue(int index)
+{
+    Value value = ToValue(E, index);
+    Write(uint8(value.tag));
+
+    switch (value.tag)
+    {
+        case VALUE_NUMBER:
+            Write(value.number);
+            break;
+        case VALUE_INTEGER:
+        case VALUE_INT64:
+        case VALUE_GUID:
+            Write(value.integer);
+            break;
+        case VALUE_STRING:
+            Write(uint32(value.string.size()));
+            buffer.insert(buffer.end(), value.string.begin(), value.string.end());
+            break;
+        case VALUE_OBJECT:
+            Write(uint8(value.string.size()));
+            buffer.insert(buffer.end(), value.string.begin(), value.string.begin() + uint8(value.string.size()));
+            Write(value.integer);
+            break;
+        case VALUE_OTHER:
+            Write(uint8(value.integer));
+            break;
+        default:
+            break;
+    }
+}
+
+void ElunaHookTrace::RecordHook(Key const& key, uint32 depth, int firstArgument, int count)
+{
+    if (full)
+    {
+        // Keep the nesting so results are not attributed to an outer hook
+        openHooks.push_back(0);
+        return;
+    }
+
+    uint32 id = nextHook++;
+    openHooks.push_back(id);
+
+    Write(uint8(RECORD_HOOK));
+    Write(id);
+    Write(ElunaUtil::GetCurrTimeUs() - startTime);
+    Write(uint8(depth));
+    Write(key.regtype);
+    Write(key.uniqueRegtype);
+    Write(key.event);
+    Write(key.entry);
+    Write(key.guid);
+    Write(key.instanceId);
+    Write(uint8(count));
+    for (int i = 0; i < count; ++i)
+        WriteValue(firstArgument + i);
+
+    if (buffer.size() >= FLUSH_SIZE)
+        Flush();
+}
+
+void ElunaHookTrace::RecordResult(uint64 duration, int firstResult, int count)
+{
+    if (openHooks.empty() || !openHooks.back())
+        return;
+
+    Write(uint8(RECORD_RESULT));
+    Write(openHooks.back());
+    Write(uint32(duration));
+    Write(uint8(count));
+    for (int i = 0; i < count; ++i)
+        WriteValue(firstResult + i);
+
+    if (buffer.size() >= FLUSH_SIZE)
+        Flush();
+}
+
+void ElunaHookTrace::EndHook()
+{
+    if (openHooks.empty())
+        return;
+
+    if (openHooks.back())
+    {
+        Write(uint8(RECORD_END));
+        Write(openHooks.back());
+    }
+    openHooks.pop_back();
+}
+
+void ElunaHookTrace::Flush()
+{
+    if (buffer.empty())
+        return;
+
+    fwrite(buffer.data(), 1, buffer.size(), file);
+    written += buffer.size();
+    buffer.clear();
+
+    if (!full && written >= maxBytes)
+    {
+        full = true;
+        ELUNA_LOG_INFO("[Eluna]: Hook trace reached its size limit of %llu bytes, recording stopped", static_cast<unsigned long long>(maxBytes));
+    }
+}
+
+template<typename K1, typename K2>
+void ElunaHookTrace::ReplayHook(ReplayContext& context, BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, K1 const& key1, K2 const& key2, Hook const& hook)
+{
+    Eluna* E = context.E;
+    lua_State* L = E->L;
+    ReplayStats& stats = context.stats;
+    int number_of_arguments = int(hook.arguments.size());
+    int number_of_results = hook.results.empty() ? 0 : int(hook.results.front().size());
+
+    for (Value const& argument : hook.arguments)
+        PushValue(E, context.objects, argument);
+    E->push_counter = uint8(number_of_arguments);
+
+    int number_of_functions = E->SetupStack(bindings1, bindings2, key1, key2, number_of_arguments);
+    uint32 handler = 0;
+    while (number_of_functions > 0)
+    {
+        uint64 start = ElunaUtil::GetCurrTimeUs();
+        int r = E->CallOneFunction(number_of_functions, number_of_arguments, number_of_results);
+        stats.elapsed += ElunaUtil::GetCurrTimeUs() - start;
+        --number_of_functions;
+        ++stats.handlers;
+
+        bool matches = handler < hook.results.size();
+        for (int i = 0; matches && i < number_of_results; ++i)
+            matches = ToValue(E, r + i) == hook.results[handler][i];
+        if (!matches)
+            ++stats.mismatches;
+
+        lua_pop(L, number_of_results);
+        ReplayChildren(context, hook, handler, false);
+        ++handler;
+    }
+
+    // Handlers that were recorded but are no longer registered
+    if (handler < hook.results.size())
+        stats.mismatches += uint32(hook.results.size() - handler);
+    ReplayChildren(context, hook, handler, true);
+
+    E->CleanUpStack(number_of_arguments);
+}
+
+void ElunaHookTrace::ReplayChildren(ReplayContext& context, Hook const& hook, uint32 handler, bool following)
+{
+    for (size_t child : hook.children)
+    {
+        Hook const& childHook = context.hooks[child];
+        if (childHook.handler == handler || (following && childHook.handler > handler))
+            ReplayAny(context, childHook);
+    }
+}
+
+template<typename T>
+bool ElunaHookTrace::ReplayEvent(ReplayContext& context, Hook const& hook)
+{
+    auto bindings = context.E->GetBinding<EventKey<T>>(hook.key.regtype);
+    if (!bindings)
+        return false;
+
+    EventKey<T> key(static_cast<T>(hook.key.event));
+    ReplayHook(context, bindings, static_cast<BindingMap<EventKey<T>>*>(nullptr), key, key, hook);
+    return true;
+}
+
+template<typename T>
+bool ElunaHookTrace::ReplayEntry(ReplayContext& context, Hook const& hook)
+{
+    auto bindings = context.E->GetBinding<EntryKey<T>>(hook.key.regtype);
+    if (!bindings)
+        return false;
+
+    EntryKey<T> key(static_cast<T>(hook.key.event), hook.key.entry);
+    ReplayHook(context, bindings, static_cast<BindingMap<EntryKey<T>>*>(nullptr), key, key, hook);
+    return true;
+}
+
+bool ElunaHookTrace::ReplayCreature(ReplayContext& context, Hook const& hook)
+{
+    using namespace Hooks;
+
+    auto entryBindings = context.E->GetBinding<EntryKey<CreatureEvents>>(REGTYPE_CREATURE);
+    auto uniqueBindings = context.E->GetBinding<UniqueObjectKey<CreatureEvents>>(REGTYPE_CREATURE_UNIQUE);
+    if (!entryBindings || !uniqueBindings)
+        return false;
+
+    CreatureEvents event = static_cast<CreatureEvents>(hook.key.event);
+    EntryKey<CreatureEvents> entryKey(event, hook.key.entry);
+    UniqueObjectKey<CreatureEvents> uniqueKey(event, ObjectGuid(hook.key.guid), hook.key.instanceId);
+    if (hook.key.uniqueRegtype == REGTYPE_CREATURE_UNIQUE)
+        ReplayHook(context, entryBindings, uniqueBindings, entryKey, uniqueKey, hook);
+    else
+        ReplayHook(context, entryBindings, static_cast<BindingMap<EntryKey<CreatureEvents>>*>(nullptr), entryKey, entryKey, hook);
+    return true;
+}
+
+void ElunaHookTrace::ReplayAny(ReplayContext& context, Hook const& hook)
+{
+    using namespace Hooks;
+
+    // The hook runs at the nesting it was recorded at, so objects stay valid until the outermost hook ends as they did
+    uint32 eventLevel = context.E->event_level;
+    context.E->event_level = hook.depth;
+
+    bool replayed = false;
+    switch (hook.key.regtype)
+    {
+        case REGTYPE_SERVER:            replayed = ReplayEvent<ServerEvents>(context, hook); break;
+        case REGTYPE_PLAYER:            replayed = ReplayEvent<PlayerEvents>(context, hook); break;
+        case REGTYPE_GUILD:             replayed = ReplayEvent<GuildEvents>(context, hook); break;
+        case REGTYPE_GROUP:             replayed = ReplayEvent<GroupEvents>(context, hook); break;
+        case REGTYPE_VEHICLE:           replayed = ReplayEvent<VehicleEvents>(context, hook); break;
+        case REGTYPE_BG:                replayed = ReplayEvent<BGEvents>(context, hook); break;
+        case REGTYPE_PACKET:            replayed = ReplayEntry<PacketEvents>(context, hook); break;
+        case REGTYPE_CREATURE:          replayed = ReplayCreature(context, hook); break;
+        case REGTYPE_CREATURE_GOSSIP:
+        case REGTYPE_GAMEOBJECT_GOSSIP:
+        case REGTYPE_ITEM_GOSSIP:
+        case REGTYPE_PLAYER_GOSSIP:     replayed = ReplayEntry<GossipEvents>(context, hook); break;
+        case REGTYPE_GAMEOBJECT:        replayed = ReplayEntry<GameObjectEvents>(context, hook); break;
+        case REGTYPE_SPELL:             replayed = ReplayEntry<SpellEvents>(context, hook); break;
+        case REGTYPE_ITEM:              replayed = ReplayEntry<ItemEvents>(context, hook); break;
+        case REGTYPE_MAP:
+        case REGTYPE_INSTANCE:          replayed = ReplayEntry<InstanceEvents>(context, hook); break;
+        default:                        break;
+    }
+
+    context.E->event_level = eventLevel;
+
+    if (replayed)
+        ++context.stats.hooks;
+    else
+        ++context.stats.skipped;
+}
+
+bool ElunaHookTrace::Replay(Eluna* E, std::string const& path, ObjectFactory const& objects, ReplayStats& stats, std::string& error)
+{
+    stats = ReplayStats();
+
+    FILE* in = fopen(path.c_str(), "rb");
+    if (!in)
+    {
+        error = "could not open " + path;
+        return false;
+    }
+
+    std::vector<uint8> data;
+    uint8 block[4096];
+    size_t len;
+    while ((len = fread(block, 1, sizeof(block), in)) > 0)
+        data.insert(data.end(), block, block + len);
+    fclose(in);
+
+    Reader reader(data);
+    char magic[sizeof(TRACE_MAGIC)];
+    uint32 version;
+    if (!reader.Read(magic) || memcmp(magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0 || !reader.Read(version) || version != TRACE_VERSION)
+    {
+        error = path + " is not a hook trace";
+        return false;
+    }
+
+    // Results follow their hook, but hooks called from a handler are recorded in between.
+    //   A hook belongs to the hook running when it was recorded, and to the handler whose results are next
+    std::vector<Hook> hooks;
+    std::vector<size_t> roots;
+    std::vector<size_t> running;
+    std::unordered_map<uint32, size_t> hookIndex;
+    while (!reader.AtEnd())
+    {
+        uint8 type;
+        uint32 id;
+        if (!reader.Read(type) || !reader.Read(id))
+            break;
+
+        if (type == RECORD_HOOK)
+        {
+            Hook hook;
+            uint64 time;
+            uint8 count;
+            if (!reader.Read(time) || !reader.Read(hook.depth) || !reader.Read(hook.key.regtype) || !reader.Read(hook.key.uniqueRegtype) ||
+                !reader.Read(hook.key.event) || !reader.Read(hook.key.entry) || !reader.Read(hook.key.guid) || !reader.Read(hook.key.instanceId) ||
+                !reader.Read(count))
+                break;
+
+            hook.arguments.resize(count);
+            bool valid = true;
+            for (Value& argument : hook.arguments)
+                valid = valid && reader.ReadValue(argument);
+            if (!valid)
+                break;
+
+            // Hooks called from timed events, or from a hook that started before the trace, are replayed on their own
+            size_t index = hooks.size();
+            if (!running.empty())
+            {
+                Hook& caller = hooks[running.back()];
+                hook.handler = uint32(caller.results.size());
+                caller.children.push_back(index);
+            }
+            else
+            {
+                hook.handler = 0;
+                roots.push_back(index);
+            }
+
+            running.push_back(index);
+            hookIndex[id] = index;
+            hooks.push_back(std::move(hook));
+        }
+        else if (type == RECORD_RESULT)
+        {
+            uint32 duration;
+            uint8 count;
+            if (!reader.Read(duration) || !reader.Read(count))
+                break;
+
+            std::vector<Value> results(count);
+            bool valid = true;
+            for (Value& result : results)
+                valid = valid && reader.ReadValue(result);
+            if (!valid)
+                break;
+
+            auto itr = hookIndex.find(id);
+            if (itr != hookIndex.end())
+                hooks[itr->second].results.push_back(std::move(results));
+        }
+        else if (type == RECORD_END)
+        {
+            auto itr = hookIndex.find(id);
+            if (itr == hookIndex.end())
+                continue;
+
+            while (!running.empty())
+            {
+                size_t index = running.back();
+                running.pop_back();
+                if (index == itr->second)
+                    break;
+            }
+        }
+        else
+            break;
+    }
+
+    // A trace cut off by a crash or the size limit is replayed up to its last complete record
+    for (auto& bindings : E->bindingMaps)
+        if (bindings)
+            bindings->SetKeepShots(true);
+
+    ReplayContext context = { E, objects, hooks, stats };
+    for (size_t root : roots)
+        ReplayAny(context, hooks[root]);
+
+    for (auto& bindings : E->bindingMaps)
+        if (bindings)
+            bindings->SetKeepShots(false);
+    return true;
+}
@@ -0,0 +1,174 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_HOOK_TRACE_H
+#define _ELUNA_HOOK_TRACE_H
+
+#include "Common.h"
+#include "BindingMap.h"
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+class Eluna;
+class Object;
+
+/*
+ * Records hook calls of a state to a binary file and replays them into a state.
+ *
+ * Every hook call is written with its key, arguments and a timestamp, followed by the
+ *   results and run time of every handler it called and its end. Objects are written as their type and GUID.
+ *   Records are buffered and written in blocks, and recording stops once the file reaches its size limit.
+ *
+ * A replay calls the handlers bound to each recorded key with the recorded arguments and compares
+ *   their results with the recorded ones. It is meant for a state of its own that loaded the same scripts,
+ *   like the one of tools/mockhost, never for a state of a running server: handlers run with all their side effects.
+ *   Objects are recreated by the caller from their type and GUID. Hooks called from a handler are replayed
+ *   after that handler returns, at their recorded depth.
+ *   Values are written in native byte order, so a trace is replayed on the platform that recorded it.
+ */
+class ElunaHookTrace
+{
+public:
+    struct Key
+    {
+        uint8 regtype;
+        uint8 uniqueRegtype;    // REGTYPE_COUNT unless the hook also has unique bindings
+        uint32 event;
+        uint32 entry;
+        uint64 guid;
+        uint32 instanceId;
+    };
+
+    struct ReplayStats
+    {
+        uint32 hooks;
+        uint32 skipped;         // hooks of registration types the state has no bindings for
+        uint32 handlers;
+        uint32 mismatches;      // handlers with results different from the recorded ones, or missing handlers
+        uint64 elapsed;         // microseconds spent in the handlers
+    };
+
+    // Returns the object to pass to handlers for a recorded object of a type and raw GUID, or nullptr to pass nil
+    typedef std::function<Object*(std::string const& typeName, uint64 guid)> ObjectFactory;
+
+    ElunaHookTrace(Eluna* E, std::string const& path, uint64 maxBytes);
+    ~ElunaHookTrace();
+
+    ElunaHookTrace(ElunaHookTrace const&) = delete;
+    ElunaHookTrace& operator=(ElunaHookTrace const&) = delete;
+
+    bool IsOpen() const { return file != nullptr; }
+
+    template<typename T> static void SetKey(Key& key, EventKey<T> const& k) { key.event = k.event_id; }
+    template<typename T> static void SetKey(Key& key, EntryKey<T> const& k) { key.event = k.event_id; key.entry = k.entry; }
+    template<typename T> static void SetKey(Key& key, UniqueObjectKey<T> const& k) { key.event = k.event_id; key.guid = k.guid.GetRawValue(); key.instanceId = k.instance_id; }
+
+    /*
+     * Records a hook call with the `count` arguments starting at `firstArgument`.
+     */
+    void RecordHook(Key const& key, uint32 depth, int firstArgument, int count);
+
+    /*
+     * Records the `count` results starting at `firstResult` of a handler of the current hook.
+     */
+    void RecordResult(uint64 duration, int firstResult, int count);
+
+    void EndHook();
+
+    /*
+     * Replays the trace at `path` into the state. Returns false and sets `error` if the file can not be read.
+     *   The shots of the state's bindings are not used up by the replay.
+     */
+    static bool Replay(Eluna* E, std::string const& path, ObjectFactory const& objects, ReplayStats& stats, std::string& error);
+
+private:
+    enum RecordType : uint8
+    {
+        RECORD_HOOK     = 'H',
+        RECORD_RESULT   = 'R',
+        RECORD_END      = 'E'
+    };
+
+    enum ValueTag : uint8
+    {
+        VALUE_NIL,
+        VALUE_FALSE,
+        VALUE_TRUE,
+        VALUE_NUMBER,
+        VALUE_INTEGER,
+        VALUE_INT64,            // boxed long long and unsigned long long
+        VALUE_STRING,
+        VALUE_OBJECT,
+        VALUE_GUID,
+        VALUE_OTHER
+    };
+
+    struct Value
+    {
+        ValueTag tag;
+        double number;
+        int64 integer;          // also the GUID of objects and GUIDs
+        std::string string;     // also the type name of objects
+
+        bool operator==(Value const& other) const;
+    };
+
+    struct Hook
+    {
+        Key key;
+        uint8 depth;                    // event level the hook was called at
+        uint32 handler;                 // handler of the calling hook this hook was called from
+        std::vector<Value> arguments;
+        std::vector<std::vector<Value>> results;
+        std::vector<size_t> children;   // hooks called from the handlers of this hook
+    };
+
+    struct ReplayContext
+    {
+        Eluna* E;
+        ObjectFactory const& objects;
+        std::vector<Hook> const& hooks;
+        ReplayStats& stats;
+    };
+
+    class Reader;
+
+    template<typename T>
+    void Write(T value)
+    {
+        const uint8* bytes = reinterpret_cast<const uint8*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    static Value ToValue(Eluna* E, int index);
+    static void PushValue(Eluna* E, ObjectFactory const& objects, Value const& value);
+    void WriteValue(int index);
+    void Flush();
+
+    template<typename K1, typename K2>
+    static void ReplayHook(ReplayContext& context, BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, K1 const& key1, K2 const& key2, Hook const& hook);
+    template<typename T> static bool ReplayEvent(ReplayContext& context, Hook const& hook);
+    template<typename T> static bool ReplayEntry(ReplayContext& context, Hook const& hook);
+    static bool ReplayCreature(ReplayContext& context, Hook const& hook);
+    static void ReplayAny(ReplayContext& context, Hook const& hook);
+    // Replays the hooks called from `handler` of `hook`, or from all handlers from `handler` on if `following` is set
+    static void ReplayChildren(ReplayContext& context, Hook const& hook, uint32 handler, bool following);
+
+    Eluna* E;
+    FILE* file;
+    uint64 maxBytes;
+    uint64 written;
+    uint64 startTime;
+    uint32 nextHook;
+    bool full;
+    std::vector<uint8> buffer;
+    std::vector<uint32> openHooks;
+};
+
+#endif
@@ -5,11 +5,13 @@
 * Please see the included DOCS/LICENSE.md for more information
 */
 
+#include "ElunaChromeTrace.h"
 #include "ElunaCompat.h"
 #include "ElunaConfig.h"
 #include "ElunaLoader.h"
 #include "ElunaUtility.h"
 #include <fstream>
+#include <memory>
 #include <sstream>
 #include <thread>
 #include <charconv>
@@ -115,6 +117,13 @@ void ElunaLoader::LoadScripts()
 
     uint32 oldMSTime = ElunaUtil::GetCurrTime();
 
+    // the loader is the first to run, so a trace set in the config also covers loading
+    sElunaChromeTrace->StartFromConfig();
+    std::unique_ptr<ElunaChromeTrace::Recorder> trace;
+    if (sElunaChromeTrace->IsActive())
+        trace = std::make_unique<ElunaChromeTrace::Recorder>(-1, 0);
+    uint64 traceStart = ElunaUtil::GetCurrTimeUs();
+
     std::string lua_folderpath = sElunaConfig->GetConfig(CONFIG_ELUNA_SCRIPT_PATH);
     const std::string& lua_path_extra = sElunaConfig->GetConfig(CONFIG_ELUNA_REQUIRE_PATH_EXTRA);
     const std::string& lua_cpath_extra = sElunaConfig->GetConfig(CONFIG_ELUNA_REQUIRE_CPATH_EXTRA);
@@ -136,13 +145,19 @@ void ElunaLoader::LoadScripts()
     m_requirecPath.clear();
 
     // read and compile all scripts
+    uint64 phaseStart = ElunaUtil::GetCurrTimeUs();
     ReadFiles(L, lua_folderpath);
+    if (trace)
+        trace->Complete("loader", "read and compile files", phaseStart);
 
     // close temporary Lua state
     lua_close(L);
 
     // combine lists of Lua scripts and extensions
+    phaseStart = ElunaUtil::GetCurrTimeUs();
     CombineLists();
+    if (trace)
+        trace->Complete("loader", "combine lists", phaseStart);
 
     // append our custom require paths and cpaths if the config variables are not empty
     if (!lua_path_extra.empty())
@@ -159,6 +174,8 @@ void ElunaLoader::LoadScripts()
         m_requirecPath.erase(m_requirecPath.end() - 1);
 
     ELUNA_LOG_INFO("[Eluna]: Loaded and precompiled %u scripts in %u ms", uint32(m_scriptCache.size()), ElunaUtil::GetTimeDiff(oldMSTime));
+    if (trace)
+        trace->Complete("loader", "load scripts", traceStart, "\"scripts\":" + std::to_string(m_scriptCache.size()));
 
     // set the cache state to ready
     m_cacheState = SCRIPT_CACHE_READY;
@@ -345,6 +362,51 @@ void ElunaLoader::CombineLists()
 
     m_extensions.clear();
     m_scripts.clear();
+
+    IndexScripts();
+}
+
+void ElunaLoader::IndexScripts()
+{
+    m_scriptIndex.clear();
+    m_globalScripts.clear();
+    m_mapScripts.clear();
+    m_scriptIndex.reserve(m_scriptCache.size());
+
+    // the first script with a name is the one require finds
+    for (uint32 i = 0; i < m_scriptCache.size(); ++i)
+    {
+        m_scriptIndex.emplace(m_scriptCache[i].filename, i);
+        if (m_scriptCache[i].mapId != -1)
+            m_mapScripts[m_scriptCache[i].mapId];
+    }
+
+    // a map with tagged scripts runs them in load order along with the global ones
+    for (uint32 i = 0; i < m_scriptCache.size(); ++i)
+    {
+        int32 mapId = m_scriptCache[i].mapId;
+        if (mapId != -1)
+        {
+            m_mapScripts[mapId].push_back(i);
+            continue;
+        }
+
+        m_globalScripts.push_back(i);
+        for (auto& [id, scripts] : m_mapScripts)
+            scripts.push_back(i);
+    }
+}
+
+const LuaScript* ElunaLoader::GetLuaScript(const std::string& filename) const
+{
+    auto it = m_scriptIndex.find(filename);
+    return it != m_scriptIndex.end() ? &m_scriptCache[it->second] : nullptr;
+}
+
+const std::vector<uint32>& ElunaLoader::GetMapScripts(int32 mapId) const
+{
+    auto it = m_mapScripts.find(mapId);
+    return it != m_mapScripts.end() ? it->second : m_globalScripts;
 }
 
 void ElunaLoader::ReloadElunaForMap(int mapId)
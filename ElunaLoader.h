@@ -10,6 +10,8 @@
 
 #include "LuaEngine.h"
 
+#include <unordered_map>
+
 #if defined ELUNA_TRINITY
 #include <efsw/efsw.hpp>
 #endif
@@ -55,6 +57,10 @@ public:
 
     uint8 GetCacheState() const { return m_cacheState; }
     const std::vector<LuaScript>& GetLuaScripts() const { return m_scriptCache; }
+    // Returns the script `require` loads for `filename`, or nullptr if there is none
+    const LuaScript* GetLuaScript(const std::string& filename) const;
+    // Returns the indices in GetLuaScripts of the scripts to run in a state of `mapId`, in load order
+    const std::vector<uint32>& GetMapScripts(int32 mapId) const;
     const std::string& GetRequirePath() const { return m_requirePath; }
     const std::string& GetRequireCPath() const { return m_requirecPath; }
 
@@ -69,12 +75,16 @@ private:
     void ReloadScriptCache();
     void ReadFiles(lua_State* L, std::string path);
     void CombineLists();
+    void IndexScripts();
     void ProcessScript(lua_State* L, std::string filename, const size_t& filesize, const std::string& fullpath, int32 mapId);
     bool CompileScript(lua_State* L, LuaScript& script);
     static int LoadBytecodeChunk(lua_State* L, uint8* bytes, size_t len, BytecodeBuffer* buffer);
 
     std::atomic<uint8> m_cacheState;
     std::vector<LuaScript> m_scriptCache;
+    std::unordered_map<std::string, uint32> m_scriptIndex;              // filename, index of the first script with that name
+    std::vector<uint32> m_globalScripts;                                // scripts not tagged with a map
+    std::unordered_map<int32, std::vector<uint32>> m_mapScripts;        // map id, global and tagged scripts of maps with tagged scripts
     std::string m_requirePath;
     std::string m_requirecPath;
     std::list<LuaScript> m_scripts;
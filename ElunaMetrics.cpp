@@ -0,0 +1,213 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaMetrics.h"
+#include "ElunaConfig.h"
+#include "ElunaEventMgr.h"
+#include "ElunaUtility.h"
+#include "LuaEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#if defined ELUNA_WINDOWS
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+extern "C"
+{
+#include "lua.h"
+};
+
+using namespace ElunaMetricsLayout;
+
+ElunaMetrics::Recorder::Recorder(Eluna* E, uint32 interval) :
+    E(E), slot(sElunaMetrics->AcquireSlot()), interval(interval), timer(0)
+{
+    memset(values, 0, sizeof(values));
+    values[METRIC_MAP_ID] = uint64(int64(E->GetBoundMapId()));
+    values[METRIC_INSTANCE_ID] = E->GetBoundInstanceId();
+
+    if (slot)
+        Write(*slot, 1, values);
+}
+
+ElunaMetrics::Recorder::~Recorder()
+{
+    if (!slot)
+        return;
+
+    Write(*slot, 0, values);
+    sElunaMetrics->ReleaseSlot(slot);
+}
+
+void ElunaMetrics::Recorder::BeginHook()
+{
+    hookStarts.push_back(ElunaUtil::GetCurrTimeUs());
+}
+
+void ElunaMetrics::Recorder::EndHook()
+{
+    if (hookStarts.empty())
+        return;
+
+    uint64 duration = ElunaUtil::GetCurrTimeUs() - hookStarts.back();
+    hookStarts.pop_back();
+
+    ++values[METRIC_HOOKS];
+    values[METRIC_HOOK_TIME] += duration;
+    values[METRIC_HOOK_MAX_TIME] = std::max(values[METRIC_HOOK_MAX_TIME], duration);
+}
+
+void ElunaMetrics::Recorder::OnCall(bool error)
+{
+    ++values[METRIC_CALLS];
+    if (error)
+        ++values[METRIC_ERRORS];
+}
+
+void ElunaMetrics::Recorder::OnCollect(uint64 duration)
+{
+    ++values[METRIC_GC_COLLECTIONS];
+    values[METRIC_GC_TIME] += duration;
+}
+
+void ElunaMetrics::Recorder::Update(uint32 diff)
+{
+    if (!slot)
+        return;
+
+    timer += diff;
+    if (timer < interval)
+        return;
+
+    timer = 0;
+    Publish();
+}
+
+void ElunaMetrics::Recorder::Publish()
+{
+    values[METRIC_PUBLISH_TIME] = uint64(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    values[METRIC_PENDING_TIMED_EVENTS] = E->eventMgr->GetEventCount();
+    values[METRIC_HEAP_BYTES] = uint64(lua_gc(E->L, LUA_GCCOUNT, 0)) * 1024 + uint64(lua_gc(E->L, LUA_GCCOUNTB, 0));
+
+    Write(*slot, 1, values);
+
+    // The longest dispatch is reported per interval
+    values[METRIC_HOOK_MAX_TIME] = 0;
+}
+
+ElunaMetrics::ElunaMetrics() : base(nullptr), mapFailed(false), fullReported(false)
+{
+}
+
+ElunaMetrics::~ElunaMetrics()
+{
+}
+
+ElunaMetrics* ElunaMetrics::instance()
+{
+    static ElunaMetrics instance;
+    return &instance;
+}
+
+bool ElunaMetrics::MapFile(std::string const& path, uint32 slotCount)
+{
+    size_t size = GetFileSize(slotCount);
+
+#if defined ELUNA_WINDOWS
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, DWORD(uint64(size) >> 32), DWORD(size & 0xFFFFFFFF), nullptr);
+    CloseHandle(file);
+    if (!mapping)
+        return false;
+
+    // The view keeps the mapping and the file open
+    base = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    CloseHandle(mapping);
+    if (!base)
+        return false;
+
+    uint32 processId = uint32(GetCurrentProcessId());
+#else
+    int file = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0)
+        return false;
+
+    if (ftruncate(file, off_t(size)) != 0)
+    {
+        close(file);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    close(file);
+    if (mapping == MAP_FAILED)
+        return false;
+    base = mapping;
+
+    uint32 processId = uint32(getpid());
+#endif
+
+    // The file starts out zeroed, so all slots are free
+    Header* header = static_cast<Header*>(base);
+    header->version = VERSION;
+    header->slotCount = slotCount;
+    header->slotSize = sizeof(Slot);
+    header->metricCount = METRIC_COUNT;
+    header->processId = processId;
+    header->startTime = uint64(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    header->magic.store(MAGIC, std::memory_order_release);
+    return true;
+}
+
+Slot* ElunaMetrics::AcquireSlot()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (mapFailed)
+        return nullptr;
+
+    if (!base)
+    {
+        std::string const& path = sElunaConfig->GetConfig(CONFIG_ELUNA_METRICS_FILE);
+        uint32 slotCount = std::max<uint32>(sElunaConfig->GetConfig(CONFIG_ELUNA_METRICS_SLOTS), 1);
+        if (!MapFile(path, slotCount))
+        {
+            ELUNA_LOG_ERROR("[Eluna]: Could not map `%s` to publish metrics to", path.c_str());
+            mapFailed = true;
+            return nullptr;
+        }
+
+        usedSlots.assign(slotCount, false);
+        ELUNA_LOG_INFO("[Eluna]: Publishing metrics of up to %u states to `%s`", slotCount, path.c_str());
+    }
+
+    auto itr = std::find(usedSlots.begin(), usedSlots.end(), false);
+    if (itr == usedSlots.end())
+    {
+        if (!fullReported)
+            ELUNA_LOG_ERROR("[Eluna]: All %u metrics slots are taken, raise Eluna.MetricsSlots to publish the metrics of all states", uint32(usedSlots.size()));
+        fullReported = true;
+        return nullptr;
+    }
+
+    *itr = true;
+    return GetSlot(base, uint32(itr - usedSlots.begin()));
+}
+
+void ElunaMetrics::ReleaseSlot(Slot* slot)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    usedSlots[slot - GetSlot(base, 0)] = false;
+}
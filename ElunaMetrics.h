@@ -0,0 +1,90 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_METRICS_H
+#define _ELUNA_METRICS_H
+
+#include "Common.h"
+#include "ElunaMetricsLayout.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Eluna;
+
+/*
+ * Publishes the counters of every state to the memory mapped file set with Eluna.MetricsFile,
+ *   so external tools can collect them at any rate without taking locks in the server. See
+ *   ElunaMetricsLayout.h for the layout of the file and tools/metrics for a reader.
+ *
+ * Every state owns a slot of the file through its recorder. Counters are kept in the recorder and
+ *   copied to the slot every Eluna.MetricsInterval milliseconds by the state's own update.
+ */
+class ElunaMetrics
+{
+public:
+    /*
+     * Counters of one state. Only used by the thread updating the state.
+     */
+    class Recorder
+    {
+    public:
+        Recorder(Eluna* E, uint32 interval);
+        ~Recorder();
+
+        Recorder(Recorder const&) = delete;
+        Recorder& operator=(Recorder const&) = delete;
+
+        // Hook dispatches in progress, see SetupStack and CleanUpStack
+        void BeginHook();
+        void EndHook();
+
+        void OnCall(bool error);
+        void OnTimedEvent() { ++values[ElunaMetricsLayout::METRIC_TIMED_EVENTS]; }
+        void OnCollect(uint64 duration);
+        void OnQuery() { ++values[ElunaMetricsLayout::METRIC_QUERIES]; }
+
+        // Publishes the counters once the interval passed
+        void Update(uint32 diff);
+
+    private:
+        void Publish();
+
+        Eluna* E;
+        ElunaMetricsLayout::Slot* slot;     // nullptr if no slot was free
+        uint32 interval;
+        uint32 timer;
+        std::vector<uint64> hookStarts;
+        uint64 values[ElunaMetricsLayout::METRIC_COUNT];
+    };
+
+    static ElunaMetrics* instance();
+
+    /*
+     * Claims a free slot, mapping the file on first use. Returns nullptr if the file could not be mapped or all slots are taken.
+     */
+    ElunaMetricsLayout::Slot* AcquireSlot();
+    void ReleaseSlot(ElunaMetricsLayout::Slot* slot);
+
+private:
+    ElunaMetrics();
+    ~ElunaMetrics();
+    ElunaMetrics(ElunaMetrics const&) = delete;
+    ElunaMetrics& operator=(ElunaMetrics const&) = delete;
+
+    bool MapFile(std::string const& path, uint32 slotCount);
+
+    std::mutex lock;
+    void* base;                 // the mapping is kept until the process exits, states may outlive this object at shutdown
+    bool mapFailed;
+    bool fullReported;
+    std::vector<bool> usedSlots;
+};
+
+#define sElunaMetrics ElunaMetrics::instance()
+
+#endif
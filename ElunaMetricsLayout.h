@@ -0,0 +1,129 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_METRICS_LAYOUT_H
+#define _ELUNA_METRICS_LAYOUT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Layout of the file the counters of all states are published to, see Eluna.MetricsFile.
+ *   It is shared with the reader in tools/metrics, so it only depends on the standard library.
+ *
+ * The file starts with a header, followed by one slot per state. Every slot is a seqlock: the writer makes
+ *   the sequence odd, stores the values and makes it even again. A reader copies the values between two loads
+ *   of the sequence and retries if they differ or are odd, so readers never hold up the map threads.
+ */
+namespace ElunaMetricsLayout
+{
+    const uint32_t MAGIC = 0x544D4C45;  // "ELMT"
+    const uint32_t VERSION = 1;
+
+    enum Metric
+    {
+        METRIC_MAP_ID,                  // bound map of the state, -1 for the global state
+        METRIC_INSTANCE_ID,
+        METRIC_PUBLISH_TIME,            // milliseconds since the Unix epoch
+        METRIC_HOOKS,                   // hook dispatches
+        METRIC_HOOK_TIME,               // microseconds spent in hook dispatches
+        METRIC_HOOK_MAX_TIME,           // longest hook dispatch since the previous publish, in microseconds
+        METRIC_CALLS,                   // Lua calls, including handlers, timed events and script runs
+        METRIC_ERRORS,                  // Lua calls that raised an error
+        METRIC_TIMED_EVENTS,            // timed events run
+        METRIC_PENDING_TIMED_EVENTS,    // timed events waiting to run
+        METRIC_HEAP_BYTES,
+        METRIC_GC_COLLECTIONS,          // full collections forced by Eluna
+        METRIC_GC_TIME,                 // microseconds spent in them
+        METRIC_QUERIES,                 // database queries started by scripts
+        METRIC_COUNT
+    };
+
+    inline const char* GetMetricName(uint32_t metric)
+    {
+        static const char* const names[METRIC_COUNT] =
+        {
+            "map", "instance", "publish_time", "hooks", "hook_time", "hook_max_time", "calls", "errors",
+            "timed_events", "pending_timed_events", "heap_bytes", "gc_collections", "gc_time", "queries"
+        };
+        return metric < METRIC_COUNT ? names[metric] : "unknown";
+    }
+
+    struct alignas(64) Header
+    {
+        std::atomic<uint32_t> magic;    // stored last, once the rest of the header is written
+        uint32_t version;
+        uint32_t slotCount;
+        uint32_t slotSize;
+        uint32_t metricCount;
+        uint32_t processId;
+        uint64_t startTime;             // seconds since the Unix epoch
+    };
+
+    struct alignas(64) Slot
+    {
+        std::atomic<uint32_t> sequence; // odd while the slot is written
+        std::atomic<uint32_t> used;     // 1 while a state owns the slot
+        std::atomic<uint64_t> values[METRIC_COUNT];
+    };
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+        "the file is shared between processes, so its atomics can not use locks");
+
+    inline size_t GetFileSize(uint32_t slotCount)
+    {
+        return sizeof(Header) + size_t(slotCount) * sizeof(Slot);
+    }
+
+    inline Slot* GetSlot(void* base, uint32_t index)
+    {
+        return reinterpret_cast<Slot*>(static_cast<char*>(base) + sizeof(Header)) + index;
+    }
+
+    inline Slot const* GetSlot(void const* base, uint32_t index)
+    {
+        return reinterpret_cast<Slot const*>(static_cast<char const*>(base) + sizeof(Header)) + index;
+    }
+
+    // Only called by the thread that owns the slot
+    inline void Write(Slot& slot, uint32_t used, uint64_t const* values)
+    {
+        uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.used.store(used, std::memory_order_relaxed);
+        for (uint32_t i = 0; i < METRIC_COUNT; ++i)
+            slot.values[i].store(values[i], std::memory_order_relaxed);
+
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /*
+     * Copies a consistent snapshot of the slot. Returns false if the slot was being written for all `attempts`.
+     */
+    inline bool Read(Slot const& slot, uint32_t& used, uint64_t* values, uint32_t attempts = 1000)
+    {
+        for (uint32_t attempt = 0; attempt < attempts; ++attempt)
+        {
+            uint32_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before & 1)
+                continue;
+
+            used = slot.used.load(std::memory_order_relaxed);
+            for (uint32_t i = 0; i < METRIC_COUNT; ++i)
+                values[i] = slot.values[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == before)
+                return true;
+        }
+        return false;
+    }
+}
+
+#endif
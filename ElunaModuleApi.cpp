@@ -0,0 +1,181 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "Hooks.h"
+#include "ElunaModuleApi.h"
+#include "ElunaEventMgr.h"
+#include "ElunaIncludes.h"
+#include "ElunaTemplate.h"
+
+#include <cstring>
+
+static_assert(ELUNA_REGTYPE_INSTANCE + 1 == Hooks::REGTYPE_COUNT, "ElunaModuleRegisterType must match Hooks::RegisterTypes");
+static_assert(int(ELUNA_REGTYPE_CREATURE_UNIQUE) == int(Hooks::REGTYPE_CREATURE_UNIQUE), "ElunaModuleRegisterType must match Hooks::RegisterTypes");
+
+namespace
+{
+    enum BaseClass : uint8
+    {
+        BASE_NONE           = 0x0,
+        BASE_OBJECT         = 0x1,
+        BASE_WORLD_OBJECT   = 0x2,
+        BASE_UNIT           = 0x4
+    };
+
+    template<typename T>
+    void* CheckAs(Eluna* E, int narg, bool error)
+    {
+        return E->CHECKOBJ<T>(narg, error);
+    }
+
+    template<typename T>
+    void PushAs(Eluna* E, const void* object)
+    {
+        E->Push(static_cast<T const*>(object));
+    }
+
+    struct ModuleClass
+    {
+        const char* name;
+        uint8 self;         // base class bit of this class, if other classes inherit it
+        uint8 bases;        // base class bits of the classes this class inherits
+        void* (*check)(Eluna* E, int narg, bool error);
+        void (*push)(Eluna* E, const void* object);
+    };
+
+    // Classes a module can use, with the names they are registered with in RegisterMethods
+    const ModuleClass moduleClasses[] =
+    {
+        { "Object", BASE_OBJECT, BASE_NONE, &CheckAs<Object>, &PushAs<Object> },
+        { "WorldObject", BASE_WORLD_OBJECT, BASE_OBJECT, &CheckAs<WorldObject>, &PushAs<WorldObject> },
+        { "Unit", BASE_UNIT, BASE_OBJECT | BASE_WORLD_OBJECT, &CheckAs<Unit>, &PushAs<Unit> },
+        { "Player", BASE_NONE, BASE_OBJECT | BASE_WORLD_OBJECT | BASE_UNIT, &CheckAs<Player>, &PushAs<Player> },
+        { "Creature", BASE_NONE, BASE_OBJECT | BASE_WORLD_OBJECT | BASE_UNIT, &CheckAs<Creature>, &PushAs<Creature> },
+        { "GameObject", BASE_NONE, BASE_OBJECT | BASE_WORLD_OBJECT, &CheckAs<GameObject>, &PushAs<GameObject> },
+        { "Corpse", BASE_NONE, BASE_OBJECT | BASE_WORLD_OBJECT, &CheckAs<Corpse>, &PushAs<Corpse> },
+        { "Item", BASE_NONE, BASE_OBJECT, &CheckAs<Item>, &PushAs<Item> },
+#if ELUNA_EXPANSION >= EXP_WOTLK
+        { "Vehicle", BASE_NONE, BASE_NONE, &CheckAs<Vehicle>, &PushAs<Vehicle> },
+#endif
+        { "Group", BASE_NONE, BASE_NONE, &CheckAs<Group>, &PushAs<Group> },
+        { "Guild", BASE_NONE, BASE_NONE, &CheckAs<Guild>, &PushAs<Guild> },
+        { "Aura", BASE_NONE, BASE_NONE, &CheckAs<Aura>, &PushAs<Aura> },
+        { "Spell", BASE_NONE, BASE_NONE, &CheckAs<Spell>, &PushAs<Spell> },
+        { "Quest", BASE_NONE, BASE_NONE, &CheckAs<Quest>, &PushAs<Quest> },
+        { "Map", BASE_NONE, BASE_NONE, &CheckAs<Map>, &PushAs<Map> },
+        { "BattleGround", BASE_NONE, BASE_NONE, &CheckAs<BattleGround>, &PushAs<BattleGround> },
+        { "WorldPacket", BASE_NONE, BASE_NONE, &CheckAs<WorldPacket>, &PushAs<WorldPacket> }
+    };
+
+    ModuleClass const* FindClass(const char* className)
+    {
+        if (!className)
+            return nullptr;
+
+        for (ModuleClass const& moduleClass : moduleClasses)
+            if (!strcmp(moduleClass.name, className))
+                return &moduleClass;
+        return nullptr;
+    }
+
+    int RegisterMethod(lua_State* L, const char* className, const char* name, lua_CFunction function)
+    {
+        if (!className)
+        {
+            lua_pushcfunction(L, function);
+            lua_setglobal(L, name);
+            return 1;
+        }
+
+        ModuleClass const* target = FindClass(className);
+        if (!target)
+            return 0;
+
+        for (ModuleClass const& moduleClass : moduleClasses)
+        {
+            if (&moduleClass != target && !(target->self & moduleClass.bases))
+                continue;
+
+            // the metatable doubles as the method table, see ElunaTemplate::Register
+            lua_pushstring(L, moduleClass.name);
+            lua_rawget(L, LUA_REGISTRYINDEX);
+            if (lua_istable(L, -1))
+            {
+                lua_pushcfunction(L, function);
+                lua_setfield(L, -2, name);
+            }
+            lua_pop(L, 1);
+        }
+        return 1;
+    }
+
+    int PushObject(lua_State* L, const char* className, const void* object)
+    {
+        ModuleClass const* moduleClass = FindClass(className);
+        if (!moduleClass)
+            return 0;
+
+        moduleClass->push(Eluna::GetEluna(L), object);
+        return 1;
+    }
+
+    void* CheckObject(lua_State* L, int narg, const char* className, int error)
+    {
+        ModuleClass const* moduleClass = FindClass(className);
+        if (!moduleClass)
+        {
+            if (error)
+                luaL_error(L, "Unknown Eluna class %s", className ? className : "(null)");
+            return nullptr;
+        }
+
+        return moduleClass->check(Eluna::GetEluna(L), narg, error != 0);
+    }
+
+    int RegisterHook(lua_State* L, int regtype, unsigned int entry, unsigned int event, unsigned int shots, lua_CFunction callback, int nup)
+    {
+        if (regtype < 0 || regtype >= Hooks::REGTYPE_COUNT)
+            return luaL_error(L, "Unknown registration type %d", regtype);
+
+        // Unique registrations are tied to a GUID and an instance, which this interface has no way to pass
+        if (regtype == Hooks::REGTYPE_CREATURE_UNIQUE)
+            return luaL_error(L, "Unique creature events can not be registered by modules");
+
+        lua_pushcclosure(L, callback, nup);
+        int functionRef = ELUNA_REF(L, ELUNA_REF_BINDING);
+        if (functionRef < 0)
+            return luaL_error(L, "unable to make a ref to function");
+
+        return Eluna::GetEluna(L)->Register(static_cast<std::underlying_type_t<Hooks::RegisterTypes>>(regtype), entry, ObjectGuid(), 0, event, functionRef, shots);
+    }
+
+    int AddTimedEvent(lua_State* L, unsigned int delay, unsigned int repeats, lua_CFunction callback, int nup)
+    {
+        lua_pushcclosure(L, callback, nup);
+        int functionRef = ELUNA_REF(L, ELUNA_REF_TIMED_EVENT);
+        if (functionRef == LUA_REFNIL || functionRef == LUA_NOREF)
+            return luaL_error(L, "unable to make a ref to function");
+
+        Eluna::GetEluna(L)->eventMgr->GetGlobalProcessor(GLOBAL_EVENTS)->AddEvent(functionRef, delay, delay, repeats);
+        return functionRef;
+    }
+
+    const ElunaModuleApi api =
+    {
+        ELUNA_MODULE_API_VERSION,
+        &RegisterMethod,
+        &PushObject,
+        &CheckObject,
+        &RegisterHook,
+        &AddTimedEvent
+    };
+}
+
+void ElunaModule::Register(Eluna* E)
+{
+    lua_pushlightuserdata(E->L, const_cast<ElunaModuleApi*>(&api));
+    lua_setfield(E->L, LUA_REGISTRYINDEX, ELUNA_MODULE_API);
+}
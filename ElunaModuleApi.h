@@ -0,0 +1,132 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_MODULE_API_H
+#define _ELUNA_MODULE_API_H
+
+/*
+ * C interface for native Lua modules loaded with require.
+ *
+ * Eluna stores a pointer to an ElunaModuleApi in the registry of every state it opens.
+ *   A module fetches it from its luaopen function with ElunaGetModuleApi and can then
+ *   register methods on Eluna classes, push and check wrapped objects and register
+ *   hooks and timed events with C functions, without rebuilding the core.
+ *
+ * This header is plain C so modules can be written in C or C++. Functions are only
+ *   ever appended to ElunaModuleApi and ELUNA_MODULE_API_VERSION is raised when they are,
+ *   so a module built against an older header keeps working with a newer Eluna.
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "lua.h"
+
+#define ELUNA_MODULE_API "Eluna Module API"
+#define ELUNA_MODULE_API_VERSION 1
+
+/*
+ * Registration types accepted by RegisterHook, same values as Hooks::RegisterTypes.
+ *   Event IDs are the same as in the Lua Register*Event functions.
+ */
+enum ElunaModuleRegisterType
+{
+    ELUNA_REGTYPE_PACKET,
+    ELUNA_REGTYPE_SERVER,
+    ELUNA_REGTYPE_PLAYER,
+    ELUNA_REGTYPE_GUILD,
+    ELUNA_REGTYPE_GROUP,
+    ELUNA_REGTYPE_CREATURE,
+    ELUNA_REGTYPE_CREATURE_UNIQUE,
+    ELUNA_REGTYPE_VEHICLE,
+    ELUNA_REGTYPE_CREATURE_GOSSIP,
+    ELUNA_REGTYPE_GAMEOBJECT,
+    ELUNA_REGTYPE_GAMEOBJECT_GOSSIP,
+    ELUNA_REGTYPE_SPELL,
+    ELUNA_REGTYPE_ITEM,
+    ELUNA_REGTYPE_ITEM_GOSSIP,
+    ELUNA_REGTYPE_PLAYER_GOSSIP,
+    ELUNA_REGTYPE_BG,
+    ELUNA_REGTYPE_MAP,
+    ELUNA_REGTYPE_INSTANCE
+};
+
+typedef struct ElunaModuleApi
+{
+    /* ELUNA_MODULE_API_VERSION of the Eluna that filled the table */
+    unsigned int version;
+
+    /*
+     * Sets `name` to `function` on the class named `className`, or as a global function if `className` is NULL.
+     *   Setting a method on Object, WorldObject or Unit also sets it on the classes inheriting them.
+     *   Returns 0 if there is no class with that name.
+     */
+    int (*RegisterMethod)(lua_State* L, const char* className, const char* name, lua_CFunction function);
+
+    /*
+     * Pushes `object` wrapped as the class named `className`, or nil if `object` is NULL.
+     *   Object, WorldObject and Unit push the actual type of the object.
+     *   Returns 0 and pushes nothing if there is no class with that name.
+     */
+    int (*PushObject)(lua_State* L, const char* className, const void* object);
+
+    /*
+     * Returns the object at `narg` if it is a valid object of the class named `className`.
+     *   Object, WorldObject and Unit accept any class inheriting them. If `error` is not 0
+     *   a Lua error is raised instead of returning NULL.
+     */
+    void* (*CheckObject)(lua_State* L, int narg, const char* className, int error);
+
+    /*
+     * Registers `callback` as a hook handler, like the Lua Register*Event functions.
+     *   The callback is created like lua_pushcclosure and closes over the top `nup` values,
+     *   which are popped. Pushes the function that cancels the registration and returns 1.
+     *   `entry` is ignored for registration types that have no entry.
+     */
+    int (*RegisterHook)(lua_State* L, int regtype, unsigned int entry, unsigned int event, unsigned int shots, lua_CFunction callback, int nup);
+
+    /*
+     * Adds a global timed event calling `callback` every `delay` milliseconds, `repeats` times or forever if 0.
+     *   The callback closes over the top `nup` values, which are popped.
+     *   Returns the event ID, which can be removed with RemoveEventById.
+     */
+    int (*AddTimedEvent)(lua_State* L, unsigned int delay, unsigned int repeats, lua_CFunction callback, int nup);
+} ElunaModuleApi;
+
+/*
+ * Returns the Eluna module API of the state, or NULL if the state was not opened by Eluna
+ *   or Eluna is older than the header the module was built with.
+ */
+static inline const ElunaModuleApi* ElunaGetModuleApi(lua_State* L)
+{
+    const ElunaModuleApi* api;
+
+    lua_getfield(L, LUA_REGISTRYINDEX, ELUNA_MODULE_API);
+    api = (const ElunaModuleApi*)lua_touserdata(L, -1);
+    lua_pop(L, 1);
+
+    if (api && api->version < ELUNA_MODULE_API_VERSION)
+        return NULL;
+    return api;
+}
+
+#ifdef __cplusplus
+}
+
+class Eluna;
+
+namespace ElunaModule
+{
+    /*
+     * Stores the module API in the registry of the state.
+     */
+    void Register(Eluna* E);
+}
+#endif
+
+#endif
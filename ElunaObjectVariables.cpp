@@ -0,0 +1,229 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaObjectVariables.h"
+#include "ElunaCompat.h"
+#include "ElunaRefTracker.h"
+
+ElunaObjectVariables::ElunaObjectVariables(lua_State* L) : L(L)
+{
+}
+
+ElunaObjectVariables::~ElunaObjectVariables()
+{
+    Clear();
+}
+
+void ElunaObjectVariables::Push(Key const& key, int field)
+{
+    field = lua_absindex(L, field);
+
+    auto itr = objects.find(key);
+    if (itr == objects.end())
+    {
+        lua_pushnil(L);
+        return;
+    }
+
+    Variables const& variables = itr->second;
+    if (variables.tableRef != LUA_NOREF)
+    {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, variables.tableRef);
+        lua_pushvalue(L, field);
+        lua_rawget(L, -2);
+        lua_remove(L, -2);
+        return;
+    }
+
+    // Only string fields are stored natively, anything else is kept in the table
+    if (lua_type(L, field) != LUA_TSTRING)
+    {
+        lua_pushnil(L);
+        return;
+    }
+
+    size_t len;
+    const char* name = lua_tolstring(L, field, &len);
+    auto slot = variables.slots.find(std::string(name, len));
+    if (slot == variables.slots.end())
+    {
+        lua_pushnil(L);
+        return;
+    }
+
+    PushSlot(slot->second);
+}
+
+void ElunaObjectVariables::PushTable(Key const& key)
+{
+    Variables& variables = objects.try_emplace(key, Variables{ {}, LUA_NOREF }).first->second;
+    if (variables.tableRef == LUA_NOREF)
+    {
+        lua_createtable(L, 0, int(variables.slots.size()));
+        for (auto const& slot : variables.slots)
+        {
+            lua_pushlstring(L, slot.first.c_str(), slot.first.size());
+            PushSlot(slot.second);
+            lua_rawset(L, -3);
+            UnrefSlot(slot.second);
+        }
+        variables.slots.clear();
+
+        lua_pushvalue(L, -1);
+        variables.tableRef = ELUNA_REF(L, ELUNA_REF_OBJECT_VARIABLES);
+        return;
+    }
+
+    lua_rawgeti(L, LUA_REGISTRYINDEX, variables.tableRef);
+}
+
+void ElunaObjectVariables::Set(Key const& key, int field, int value)
+{
+    field = lua_absindex(L, field);
+    value = lua_absindex(L, value);
+
+    auto itr = objects.find(key);
+    if (itr == objects.end())
+    {
+        if (lua_isnil(L, value))
+            return;
+        itr = objects.emplace(key, Variables{ {}, LUA_NOREF }).first;
+    }
+
+    Variables& variables = itr->second;
+    if (variables.tableRef == LUA_NOREF && lua_type(L, field) != LUA_TSTRING)
+    {
+        // Fields that are not strings need the table
+        PushTable(key);
+        lua_pop(L, 1);
+    }
+
+    if (variables.tableRef != LUA_NOREF)
+    {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, variables.tableRef);
+        lua_pushvalue(L, field);
+        lua_pushvalue(L, value);
+        lua_rawset(L, -3);
+        lua_pop(L, 1);
+        return;
+    }
+
+    size_t len;
+    const char* name = lua_tolstring(L, field, &len);
+    std::string fieldName(name, len);
+
+    auto slot = variables.slots.find(fieldName);
+    if (slot != variables.slots.end())
+    {
+        UnrefSlot(slot->second);
+        if (lua_isnil(L, value))
+        {
+            variables.slots.erase(slot);
+            if (variables.slots.empty())
+                objects.erase(itr);
+            return;
+        }
+    }
+    else
+    {
+        if (lua_isnil(L, value))
+            return;
+        slot = variables.slots.emplace(std::move(fieldName), Slot()).first;
+    }
+
+    Slot& newSlot = slot->second;
+    switch (lua_type(L, value))
+    {
+        case LUA_TBOOLEAN:
+            newSlot.type = Slot::SLOT_BOOLEAN;
+            newSlot.boolean = lua_toboolean(L, value) != 0;
+            break;
+        case LUA_TNUMBER:
+#if LUA_VERSION_NUM > 502
+            if (lua_isinteger(L, value))
+            {
+                newSlot.type = Slot::SLOT_INTEGER;
+                newSlot.integer = int64(lua_tointeger(L, value));
+                break;
+            }
+#endif
+            newSlot.type = Slot::SLOT_NUMBER;
+            newSlot.number = lua_tonumber(L, value);
+            break;
+        default:
+            lua_pushvalue(L, value);
+            newSlot.type = Slot::SLOT_REF;
+            newSlot.ref = ELUNA_REF(L, ELUNA_REF_OBJECT_VARIABLES);
+            break;
+    }
+}
+
+void ElunaObjectVariables::Remove(Key const& key)
+{
+    auto itr = objects.find(key);
+    if (itr == objects.end())
+        return;
+
+    Unref(itr->second);
+    objects.erase(itr);
+}
+
+void ElunaObjectVariables::RemoveMap(uint32 mapId, uint32 instanceId)
+{
+    for (auto itr = objects.begin(); itr != objects.end();)
+    {
+        if (itr->first.mapId == mapId && itr->first.instanceId == instanceId)
+        {
+            Unref(itr->second);
+            itr = objects.erase(itr);
+        }
+        else
+            ++itr;
+    }
+}
+
+void ElunaObjectVariables::Clear()
+{
+    for (auto& object : objects)
+        Unref(object.second);
+    objects.clear();
+}
+
+void ElunaObjectVariables::PushSlot(Slot const& slot) const
+{
+    switch (slot.type)
+    {
+        case Slot::SLOT_BOOLEAN:
+            lua_pushboolean(L, slot.boolean);
+            break;
+        case Slot::SLOT_NUMBER:
+            lua_pushnumber(L, slot.number);
+            break;
+        case Slot::SLOT_INTEGER:
+            lua_pushinteger(L, lua_Integer(slot.integer));
+            break;
+        case Slot::SLOT_REF:
+            lua_rawgeti(L, LUA_REGISTRYINDEX, slot.ref);
+            break;
+    }
+}
+
+void ElunaObjectVariables::UnrefSlot(Slot const& slot) const
+{
+    if (slot.type == Slot::SLOT_REF)
+        ELUNA_UNREF(L, slot.ref);
+}
+
+void ElunaObjectVariables::Unref(Variables& variables) const
+{
+    for (auto const& slot : variables.slots)
+        UnrefSlot(slot.second);
+    variables.slots.clear();
+
+    if (variables.tableRef != LUA_NOREF)
+        ELUNA_UNREF(L, variables.tableRef);
+    variables.tableRef = LUA_NOREF;
+}
@@ -0,0 +1,110 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_OBJECT_VARIABLES_H
+#define _ELUNA_OBJECT_VARIABLES_H
+
+#include "Common.h"
+
+#include <string>
+#include <unordered_map>
+
+struct lua_State;
+
+/*
+ * Per-state variables attached to maps and world objects with GetData and SetData.
+ *
+ * Booleans and numbers are stored natively, other values are referenced from the registry.
+ *   A Lua table is only created when a script asks for all variables of an object,
+ *   after which the table holds the variables so changes made to it are kept.
+ *
+ * Variables are removed natively when their object is removed from the world,
+ *   a player logs out or a map is created or destroyed.
+ */
+class ElunaObjectVariables
+{
+public:
+    struct Key
+    {
+        uint32 mapId;
+        uint32 instanceId;
+        uint64 guid;        // raw GUID of the object, 0 for the map itself
+
+        bool operator==(Key const& other) const { return mapId == other.mapId && instanceId == other.instanceId && guid == other.guid; }
+    };
+
+    // Map ID used in the keys of players, their variables are kept over map changes
+    static const uint32 PLAYER_MAP_ID = 0xFFFFFFFF;
+
+    ElunaObjectVariables(lua_State* L);
+    ~ElunaObjectVariables();
+
+    ElunaObjectVariables(ElunaObjectVariables const&) = delete;
+    ElunaObjectVariables& operator=(ElunaObjectVariables const&) = delete;
+
+    /*
+     * Pushes the variable named by the value at `field`, or nil if it is not set.
+     */
+    void Push(Key const& key, int field);
+
+    /*
+     * Pushes a table of all variables of the object, creating it on first use.
+     */
+    void PushTable(Key const& key);
+
+    /*
+     * Sets the variable named by the value at `field` to the value at `value`. A nil value removes it.
+     */
+    void Set(Key const& key, int field, int value);
+
+    void Remove(Key const& key);
+    void RemoveMap(uint32 mapId, uint32 instanceId);
+    void Clear();
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(Key const& key) const
+        {
+            return std::hash<uint64>()(key.guid) ^ (std::hash<uint64>()((uint64(key.mapId) << 32) | key.instanceId) << 1);
+        }
+    };
+
+    struct Slot
+    {
+        enum Type : uint8
+        {
+            SLOT_BOOLEAN,
+            SLOT_NUMBER,
+            SLOT_INTEGER,   // Lua 5.3+ integers, kept apart from floats
+            SLOT_REF
+        };
+
+        Type type;
+        union
+        {
+            bool boolean;
+            double number;
+            int64 integer;
+            int ref;
+        };
+    };
+
+    struct Variables
+    {
+        std::unordered_map<std::string, Slot> slots;
+        int tableRef;       // LUA_NOREF until the table is created
+    };
+
+    void PushSlot(Slot const& slot) const;
+    void UnrefSlot(Slot const& slot) const;
+    void Unref(Variables& variables) const;
+
+    lua_State* L;
+    std::unordered_map<Key, Variables, KeyHash> objects;
+};
+
+#endif
@@ -0,0 +1,97 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaRefTracker.h"
+#include "LuaEngine.h"
+#include "ElunaUtility.h"
+
+#include <map>
+#include <string>
+#include <tuple>
+
+int ElunaRefTracker::Ref(lua_State* L, ElunaRefCategory category, const char* file, int line)
+{
+    int ref = luaL_ref(L, LUA_REGISTRYINDEX);
+    if (ref >= 0)
+        if (ElunaRefTracker* tracker = Eluna::GetEluna(L)->refTracker.get())
+            tracker->Add(ref, category, file, line);
+    return ref;
+}
+
+void ElunaRefTracker::Unref(lua_State* L, int ref)
+{
+    // LUA_NOREF and LUA_REFNIL are never tracked and unreferencing them does nothing
+    if (ref >= 0)
+        if (ElunaRefTracker* tracker = Eluna::GetEluna(L)->refTracker.get())
+            if (!tracker->Remove(ref))
+                ELUNA_LOG_ERROR("[Eluna]: Released registry reference %d, which is not tracked or was already released", ref);
+
+    luaL_unref(L, LUA_REGISTRYINDEX, ref);
+}
+
+const char* ElunaRefTracker::GetCategoryName(ElunaRefCategory category)
+{
+    switch (category)
+    {
+        case ELUNA_REF_BINDING:             return "binding";
+        case ELUNA_REF_TIMED_EVENT:         return "timed_event";
+        case ELUNA_REF_QUERY_CALLBACK:      return "query_callback";
+        case ELUNA_REF_INSTANCE_DATA:       return "instance_data";
+        case ELUNA_REF_COMMAND:             return "command";
+        case ELUNA_REF_CHAT_FILTER:         return "chat_filter";
+        case ELUNA_REF_OBJECT_VARIABLES:    return "object_variables";
+        case ELUNA_REF_STRING_CACHE:        return "string_cache";
+        default:                            return "unknown";
+    }
+}
+
+void ElunaRefTracker::Add(int ref, ElunaRefCategory category, const char* file, int line)
+{
+    // luaL_ref only hands out free references, so a tracked one was released without ELUNA_UNREF
+    auto itr = refs.find(ref);
+    if (itr != refs.end())
+    {
+        ELUNA_LOG_ERROR("[Eluna]: Registry reference %d created at %s:%d was released untracked", ref, itr->second.file, itr->second.line);
+        --counts[itr->second.category];
+        refs.erase(itr);
+    }
+
+    refs.emplace(ref, Entry{ category, file, line });
+    ++counts[category];
+}
+
+bool ElunaRefTracker::Remove(int ref)
+{
+    auto itr = refs.find(ref);
+    if (itr == refs.end())
+        return false;
+
+    --counts[itr->second.category];
+    refs.erase(itr);
+    return true;
+}
+
+void ElunaRefTracker::ReportLeaks(int32 mapId, uint32 instanceId) const
+{
+    if (refs.empty())
+        return;
+
+    // Sites are compared by contents, the same file name can have several addresses
+    typedef std::tuple<std::string, int, ElunaRefCategory> Site;
+    std::map<Site, uint32> sites;
+    for (auto const& ref : refs)
+        ++sites[Site(ref.second.file, ref.second.line, ref.second.category)];
+
+    ELUNA_LOG_ERROR("[Eluna]: %u registry references of map: %i, instance: %u were not released before the state closed",
+        uint32(refs.size()), mapId, instanceId);
+    for (auto const& site : sites)
+    {
+        std::string const& file = std::get<0>(site.first);
+        size_t slash = file.find_last_of("/\\");
+        ELUNA_LOG_ERROR("[Eluna]:   %u %s references created at %s:%d", site.second, GetCategoryName(std::get<2>(site.first)),
+            file.c_str() + (slash == std::string::npos ? 0 : slash + 1), std::get<1>(site.first));
+    }
+}
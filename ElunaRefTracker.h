@@ -0,0 +1,92 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_REF_TRACKER_H
+#define _ELUNA_REF_TRACKER_H
+
+#include "Common.h"
+
+#include <array>
+#include <unordered_map>
+
+extern "C"
+{
+#include "lua.h"
+#include "lauxlib.h"
+};
+
+// Registry references are tracked in debug builds, define ELUNA_TRACK_REFS to track them in release builds as well
+#if defined ELUNA_TRACK_REFS || !defined NDEBUG
+#define ELUNA_REF_TRACKING
+#endif
+
+enum ElunaRefCategory : uint8
+{
+    ELUNA_REF_BINDING,
+    ELUNA_REF_TIMED_EVENT,
+    ELUNA_REF_QUERY_CALLBACK,
+    ELUNA_REF_INSTANCE_DATA,    // continent and instance data tables
+    ELUNA_REF_COMMAND,
+    ELUNA_REF_CHAT_FILTER,
+    ELUNA_REF_OBJECT_VARIABLES,
+    ELUNA_REF_STRING_CACHE,
+    ELUNA_REF_CATEGORY_COUNT
+};
+
+/*
+ * Keeps the owner category and creation site of every live registry reference of a state.
+ *
+ * References are created and released with ELUNA_REF and ELUNA_UNREF, which are plain luaL_ref
+ *   and luaL_unref calls when tracking is not compiled in. Owners that let their references die
+ *   with the state release them from tracking with Remove before the state closes, so the references
+ *   still tracked then were lost by their owner and are reported as leaks.
+ */
+class ElunaRefTracker
+{
+public:
+    ElunaRefTracker() : counts() { }
+
+    ElunaRefTracker(ElunaRefTracker const&) = delete;
+    ElunaRefTracker& operator=(ElunaRefTracker const&) = delete;
+
+    // Pops the value on top of the stack and returns a reference to it, tracked if the state has a tracker
+    static int Ref(lua_State* L, ElunaRefCategory category, const char* file, int line);
+    static void Unref(lua_State* L, int ref);
+
+    static const char* GetCategoryName(ElunaRefCategory category);
+
+    void Add(int ref, ElunaRefCategory category, const char* file, int line);
+    // Returns false if the reference is not tracked, like one released twice
+    bool Remove(int ref);
+
+    uint32 GetCount(ElunaRefCategory category) const { return counts[category]; }
+
+    /*
+     * Logs the references still tracked, grouped by creation site.
+     */
+    void ReportLeaks(int32 mapId, uint32 instanceId) const;
+
+private:
+    struct Entry
+    {
+        ElunaRefCategory category;
+        const char* file;
+        int line;
+    };
+
+    std::unordered_map<int, Entry> refs;
+    std::array<uint32, ELUNA_REF_CATEGORY_COUNT> counts;
+};
+
+#if defined ELUNA_REF_TRACKING
+#define ELUNA_REF(L, category) ElunaRefTracker::Ref(L, category, __FILE__, __LINE__)
+#define ELUNA_UNREF(L, ref) ElunaRefTracker::Unref(L, ref)
+#else
+#define ELUNA_REF(L, category) luaL_ref(L, LUA_REGISTRYINDEX)
+#define ELUNA_UNREF(L, ref) luaL_unref(L, LUA_REGISTRYINDEX, ref)
+#endif
+
+#endif
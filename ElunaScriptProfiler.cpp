@@ -0,0 +1,134 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaScriptProfiler.h"
+#include "ElunaUtility.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Scripts written to the log every log interval
+    const size_t LOGGED_SCRIPTS = 10;
+}
+
+ElunaScriptProfiler::Scope::Scope(ElunaScriptProfiler* profiler, uint32 scriptId) :
+    profiler(profiler), parent(nullptr), scriptId(scriptId), previousScript(0), startTime(0), startAllocated(0), childTime(0), childAllocated(0)
+{
+    if (!profiler)
+        return;
+
+    parent = profiler->activeScope;
+    profiler->activeScope = this;
+    previousScript = profiler->activeScript;
+    profiler->activeScript = scriptId;
+    startTime = ElunaUtil::GetCurrTimeUs();
+    startAllocated = profiler->allocated;
+}
+
+ElunaScriptProfiler::Scope::~Scope()
+{
+    if (!profiler)
+        return;
+
+    uint64 time = ElunaUtil::GetCurrTimeUs() - startTime;
+    uint64 allocated = profiler->allocated - startAllocated;
+    if (scriptId < profiler->scripts.size())
+    {
+        Script& script = profiler->scripts[scriptId];
+        ++script.calls;
+        script.time += time - std::min(childTime, time);
+        script.allocated += allocated - std::min(childAllocated, allocated);
+    }
+
+    profiler->activeScope = parent;
+    profiler->activeScript = previousScript;
+    if (parent)
+    {
+        parent->childTime += time;
+        parent->childAllocated += allocated;
+    }
+}
+
+ElunaScriptProfiler::ElunaScriptProfiler(lua_State* L, uint32 logInterval) :
+    L(L), allocated(0), activeScript(UNKNOWN_SCRIPT), activeScope(nullptr), logInterval(logInterval * 1000), logTimer(0)
+{
+    scripts.push_back({ "?", 0, 0, 0 });
+
+    allocf = lua_getallocf(L, &allocud);
+    lua_setallocf(L, &Allocate, this);
+}
+
+ElunaScriptProfiler::~ElunaScriptProfiler()
+{
+    lua_setallocf(L, allocf, allocud);
+}
+
+void* ElunaScriptProfiler::Allocate(void* ud, void* ptr, size_t osize, size_t nsize)
+{
+    ElunaScriptProfiler* profiler = static_cast<ElunaScriptProfiler*>(ud);
+
+    // osize is the type of a new object instead of a size when ptr is NULL on Lua 5.2 and later
+    size_t oldSize = ptr ? osize : 0;
+    if (nsize > oldSize)
+        profiler->allocated += nsize - oldSize;
+
+    return profiler->allocf(profiler->allocud, ptr, osize, nsize);
+}
+
+uint32 ElunaScriptProfiler::GetScriptId(std::string const& path)
+{
+    auto itr = scriptIds.find(path);
+    if (itr != scriptIds.end())
+        return itr->second;
+
+    uint32 scriptId = uint32(scripts.size());
+    scripts.push_back({ path, 0, 0, 0 });
+    scriptIds.emplace(path, scriptId);
+    return scriptId;
+}
+
+std::vector<ElunaScriptProfiler::Script> ElunaScriptProfiler::GetScripts() const
+{
+    std::vector<Script> result;
+    for (Script const& script : scripts)
+        if (script.calls)
+            result.push_back(script);
+
+    std::sort(result.begin(), result.end(), [](Script const& a, Script const& b) { return a.time > b.time; });
+    return result;
+}
+
+void ElunaScriptProfiler::Reset()
+{
+    for (Script& script : scripts)
+    {
+        script.calls = 0;
+        script.time = 0;
+        script.allocated = 0;
+    }
+}
+
+void ElunaScriptProfiler::Update(uint32 diff, int32 mapId, uint32 instanceId)
+{
+    if (!logInterval)
+        return;
+
+    logTimer += diff;
+    if (logTimer < logInterval)
+        return;
+    logTimer = 0;
+
+    std::vector<Script> top = GetScripts();
+    if (top.empty())
+        return;
+
+    ELUNA_LOG_INFO("[Eluna]: Script profile for map: %i, instance: %u", mapId, instanceId);
+    for (size_t i = 0; i < top.size() && i < LOGGED_SCRIPTS; ++i)
+        ELUNA_LOG_INFO("[Eluna]:   `%s`: %llu calls, %llu ms, %llu KB allocated", top[i].path.c_str(),
+            static_cast<unsigned long long>(top[i].calls), static_cast<unsigned long long>(top[i].time / 1000),
+            static_cast<unsigned long long>(top[i].allocated / 1024));
+}
@@ -0,0 +1,109 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_SCRIPT_PROFILER_H
+#define _ELUNA_SCRIPT_PROFILER_H
+
+#include "Common.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern "C"
+{
+#include "lua.h"
+};
+
+/*
+ * Attributes handler run time, calls and allocated bytes to the script files of a state.
+ *
+ * The script a file is loaded from is remembered by every hook binding and timed event it registers,
+ *   including ones registered later from its handlers. Time and allocations of handlers called from
+ *   other handlers, like nested hooks, count only for their own script.
+ *   Allocations are counted by wrapping the allocator of the state, so the profiler must be destroyed
+ *   before the state is closed.
+ *
+ * Only created when Eluna.ScriptProfiling is enabled.
+ */
+class ElunaScriptProfiler
+{
+public:
+    struct Script
+    {
+        std::string path;
+        uint64 calls;
+        uint64 time;            // microseconds
+        uint64 allocated;       // bytes
+    };
+
+    /*
+     * Attributes everything run while it exists to a script, does nothing without a profiler.
+     */
+    class Scope
+    {
+    public:
+        Scope(ElunaScriptProfiler* profiler, uint32 scriptId);
+        ~Scope();
+
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+
+    private:
+        ElunaScriptProfiler* profiler;
+        Scope* parent;
+        uint32 scriptId;
+        uint32 previousScript;
+        uint64 startTime;
+        uint64 startAllocated;
+        uint64 childTime;       // spent in nested scopes, which is attributed to their scripts
+        uint64 childAllocated;
+    };
+
+    // ID of code not loaded from a script file, like the console or other states
+    static const uint32 UNKNOWN_SCRIPT = 0;
+
+    ElunaScriptProfiler(lua_State* L, uint32 logInterval);
+    ~ElunaScriptProfiler();
+
+    ElunaScriptProfiler(ElunaScriptProfiler const&) = delete;
+    ElunaScriptProfiler& operator=(ElunaScriptProfiler const&) = delete;
+
+    uint32 GetScriptId(std::string const& path);
+
+    // Script whose code is running, bindings and events registered now belong to it
+    uint32 GetActiveScript() const { return activeScript; }
+    void SetActiveScript(uint32 scriptId) { activeScript = scriptId; }
+
+    /*
+     * Returns the scripts that ran any handlers, sorted by run time.
+     */
+    std::vector<Script> GetScripts() const;
+    void Reset();
+
+    /*
+     * Logs the scripts with the highest run time every log interval.
+     */
+    void Update(uint32 diff, int32 mapId, uint32 instanceId);
+
+private:
+    static void* Allocate(void* ud, void* ptr, size_t osize, size_t nsize);
+
+    lua_State* L;
+    lua_Alloc allocf;
+    void* allocud;
+    uint64 allocated;
+
+    uint32 activeScript;
+    Scope* activeScope;
+    std::vector<Script> scripts;
+    std::unordered_map<std::string, uint32> scriptIds;
+
+    uint32 logInterval;     // milliseconds, 0 if disabled
+    uint32 logTimer;
+};
+
+#endif
@@ -0,0 +1,142 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaSlowHandlers.h"
+#include "LuaEngine.h"
+#include "ElunaUtility.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    // Instructions run between two checks of the sampling hook
+    const int SAMPLE_INSTRUCTIONS = 1000;
+
+    // Frames written to a sampled traceback
+    const int MAX_TRACEBACK_FRAMES = 16;
+}
+
+ElunaSlowHandlers::ElunaSlowHandlers(Eluna* E, uint32 threshold, uint32 reportInterval, bool tracebacks) :
+    E(E), threshold(uint64(threshold) * 1000), reportInterval(uint64(reportInterval) * 1000000), tracebacks(tracebacks),
+    handlerCall(false), sampling(false), sampleStart(0)
+{
+}
+
+ElunaSlowHandlers::~ElunaSlowHandlers()
+{
+    if (lua_gethook(E->L) == &SampleHook)
+        lua_sethook(E->L, nullptr, 0, 0);
+}
+
+void ElunaSlowHandlers::SampleHook(lua_State* L, lua_Debug* /*ar*/)
+{
+    ElunaSlowHandlers* slowHandlers = Eluna::GetEluna(L)->slowHandlers.get();
+
+    // Coroutines inherit the hook, it is removed from them once the call that installed it ended
+    if (!slowHandlers || !slowHandlers->sampleStart)
+    {
+        lua_sethook(L, nullptr, 0, 0);
+        return;
+    }
+
+    if (ElunaUtil::GetCurrTimeUs() - slowHandlers->sampleStart < slowHandlers->threshold)
+        return;
+
+    // One sample per call is enough to show where it got stuck
+    lua_sethook(L, nullptr, 0, 0);
+
+    lua_Debug frame;
+    for (int level = 0; level < MAX_TRACEBACK_FRAMES && lua_getstack(L, level, &frame); ++level)
+    {
+        lua_getinfo(L, "Sln", &frame);
+
+        char line[256];
+        if (frame.currentline > 0)
+            snprintf(line, sizeof(line), "\n\t%s:%d: in %s", frame.short_src, frame.currentline, frame.name ? frame.name : "?");
+        else
+            snprintf(line, sizeof(line), "\n\t%s: in %s", frame.short_src, frame.name ? frame.name : "?");
+        slowHandlers->sample += line;
+    }
+}
+
+void ElunaSlowHandlers::Begin(Call& call)
+{
+    call.handler = handlerCall && !hooks.empty();
+    handlerCall = false;
+    call.sampling = false;
+    call.startTime = ElunaUtil::GetCurrTimeUs();
+
+    // Only the outermost call samples, and never over a hook set by the scripts
+    if (tracebacks && !sampling && !lua_gethook(E->L))
+    {
+        call.sampling = true;
+        sampling = true;
+        sampleStart = call.startTime;
+        sample.clear();
+        lua_sethook(E->L, &SampleHook, LUA_MASKCOUNT, SAMPLE_INSTRUCTIONS);
+    }
+}
+
+void ElunaSlowHandlers::End(Call& call, int function)
+{
+    uint64 duration = ElunaUtil::GetCurrTimeUs() - call.startTime;
+
+    if (call.sampling)
+    {
+        if (lua_gethook(E->L) == &SampleHook)
+            lua_sethook(E->L, nullptr, 0, 0);
+        sampling = false;
+        sampleStart = 0;
+    }
+
+    if (duration >= threshold)
+        Report(duration, function, call);
+}
+
+void ElunaSlowHandlers::Report(uint64 duration, int function, Call const& call)
+{
+    lua_Debug ar;
+    lua_pushvalue(E->L, function);
+    lua_getinfo(E->L, ">S", &ar);
+    std::string location = std::string(ar.short_src) + ":" + std::to_string(ar.linedefined);
+
+    uint64 now = ElunaUtil::GetCurrTimeUs();
+    Site& site = sites.emplace(location, Site{ 0, 0, 0 }).first->second;
+    if (site.lastReport && now - site.lastReport < reportInterval)
+    {
+        ++site.suppressed;
+        site.suppressedMax = std::max(site.suppressedMax, duration);
+        return;
+    }
+
+    std::string context;
+    if (call.handler)
+    {
+        ElunaHookTrace::Key const& key = hooks.back();
+        char buffer[160];
+        snprintf(buffer, sizeof(buffer), ", regtype: %u, event: %u, entry: %u, guid: %llu, instance: %u",
+            key.regtype, key.event, key.entry, static_cast<unsigned long long>(key.guid), key.instanceId);
+        context = buffer;
+    }
+
+    std::string summary;
+    if (site.suppressed)
+    {
+        char buffer[128];
+        snprintf(buffer, sizeof(buffer), ", %u more slow calls since the last report taking up to %llu ms",
+            site.suppressed, static_cast<unsigned long long>(site.suppressedMax / 1000));
+        summary = buffer;
+    }
+
+    ELUNA_LOG_ERROR("[Eluna]: Call of `%s` took %llu ms (map: %i, instance: %u%s)%s%s%s", location.c_str(),
+        static_cast<unsigned long long>(duration / 1000), E->GetBoundMapId(), E->GetBoundInstanceId(), context.c_str(), summary.c_str(),
+        call.sampling && !sample.empty() ? ", sampled traceback:" : "", call.sampling ? sample.c_str() : "");
+
+    site.lastReport = now;
+    site.suppressed = 0;
+    site.suppressedMax = 0;
+}
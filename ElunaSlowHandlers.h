@@ -0,0 +1,94 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_SLOW_HANDLERS_H
+#define _ELUNA_SLOW_HANDLERS_H
+
+#include "Common.h"
+#include "ElunaHookTrace.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern "C"
+{
+#include "lua.h"
+};
+
+class Eluna;
+
+/*
+ * Times every Lua call of a state and logs the ones that take longer than a threshold.
+ *
+ * A report names the source location of the called function and, for hook handlers, the key of the hook.
+ *   Reports are rate limited per source location: slow calls within the report interval of the previous
+ *   report are only counted and summarized in the next one.
+ *
+ * With tracebacks enabled, an instruction count hook is installed during the outermost call, which samples
+ *   a traceback once the call runs past the threshold, showing where the time went. The hook is not installed
+ *   if the scripts set their own.
+ *
+ * Only created when Eluna.SlowHandlerThreshold is set.
+ */
+class ElunaSlowHandlers
+{
+public:
+    struct Call
+    {
+        uint64 startTime;
+        bool handler;       // the call is a handler of the innermost hook
+        bool sampling;      // the call installed the sampling hook
+    };
+
+    ElunaSlowHandlers(Eluna* E, uint32 threshold, uint32 reportInterval, bool tracebacks);
+    ~ElunaSlowHandlers();
+
+    ElunaSlowHandlers(ElunaSlowHandlers const&) = delete;
+    ElunaSlowHandlers& operator=(ElunaSlowHandlers const&) = delete;
+
+    // Hooks whose handlers are being called, see SetupStack and CleanUpStack
+    void PushHook(ElunaHookTrace::Key const& key) { hooks.push_back(key); }
+    void PopHook() { hooks.pop_back(); }
+
+    // Marks the next call as a handler of the innermost hook
+    void SetHandlerCall() { handlerCall = true; }
+
+    void Begin(Call& call);
+
+    /*
+     * Ends a call begun with Begin, the called function has to be at `function` on the stack.
+     */
+    void End(Call& call, int function);
+
+private:
+    struct Site
+    {
+        uint64 lastReport;
+        uint32 suppressed;      // slow calls since the last report
+        uint64 suppressedMax;
+    };
+
+    static void SampleHook(lua_State* L, lua_Debug* ar);
+
+    void Report(uint64 duration, int function, Call const& call);
+
+    Eluna* E;
+    uint64 threshold;           // microseconds
+    uint64 reportInterval;      // microseconds
+    bool tracebacks;
+
+    std::vector<ElunaHookTrace::Key> hooks;
+    bool handlerCall;
+
+    bool sampling;              // a call that installed the sampling hook is running, it stays set after the sample removed the hook
+    uint64 sampleStart;
+    std::string sample;
+
+    std::unordered_map<std::string, Site> sites;
+};
+
+#endif
@@ -0,0 +1,62 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_SPAWN_GROUP_H
+#define _ELUNA_SPAWN_GROUP_H
+
+#include "LuaEngine.h"
+
+#include <cmath>
+#include <vector>
+
+struct ElunaSpawnGroupMember
+{
+    ObjectGuid guid;
+    float x;
+    float y;
+    float z;
+    float o;
+};
+
+/*
+ * Objects spawned together by WorldObject:SpawnCreatures or WorldObject:SpawnGameObjects.
+ *
+ * Only the GUIDs and formation positions are stored, the objects are looked up
+ *   from the map when needed, so a group never keeps a despawned object alive.
+ */
+class ElunaSpawnGroup
+{
+public:
+    ElunaSpawnGroup(uint32 mapId, uint32 instanceId) : mapId(mapId), instanceId(instanceId)
+    {
+    }
+
+    /*
+     * Converts a formation offset relative to an anchor into a world position.
+     *   The x offset points in the anchor's facing direction and the y offset to its left.
+     */
+    static void ApplyOffset(float anchorX, float anchorY, float anchorZ, float anchorO, ElunaSpawnGroupMember& member)
+    {
+        float offsetX = member.x;
+        float offsetY = member.y;
+        float cosO = std::cos(anchorO);
+        float sinO = std::sin(anchorO);
+
+        member.x = anchorX + offsetX * cosO - offsetY * sinO;
+        member.y = anchorY + offsetX * sinO + offsetY * cosO;
+        member.z = anchorZ + member.z;
+        member.o = std::fmod(anchorO + member.o, 2.0f * float(M_PI));
+        if (member.o < 0.0f)
+            member.o += 2.0f * float(M_PI);
+    }
+
+    uint32 mapId;
+    uint32 instanceId;
+    std::vector<ElunaSpawnGroupMember> creatures;
+    std::vector<ElunaSpawnGroupMember> gameObjects;
+};
+
+#endif
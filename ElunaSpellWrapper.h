@@ -9,13 +9,19 @@
 class Unit;
 class Spell;
 class Map;
-class SpellInfo;
 class ProcEventInfo;
 class DamageInfo;
 class HealInfo;
+#if defined ELUNA_TRINITY || defined ELUNA_AZEROTHCORE
+class SpellInfo;
+#else
+struct SpellEntry;
+typedef SpellEntry SpellInfo;
+#endif
+// The other cores define SpellSchoolMask in SharedDefines.h
 #ifdef ELUNA_TRINITY
 enum SpellSchoolMask : uint32;
-#else
+#elif defined ELUNA_AZEROTHCORE
 enum SpellSchoolMask;
 #endif
 enum DamageEffectType : uint8;
@@ -0,0 +1,64 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaStringCache.h"
+#include "ElunaRefTracker.h"
+
+extern "C"
+{
+#include "lua.h"
+#include "lauxlib.h"
+};
+
+ElunaStringCache::ElunaStringCache(lua_State* L) : L(L)
+{
+}
+
+ElunaStringCache::~ElunaStringCache()
+{
+    Clear();
+}
+
+std::string const* ElunaStringCache::Find(Kind kind, uint32 entry, uint8 locale) const
+{
+    auto itr = strings.find(MakeKey(kind, entry, locale));
+    if (itr == strings.end())
+        return nullptr;
+    return &itr->second.value;
+}
+
+bool ElunaStringCache::Push(Kind kind, uint32 entry, uint8 locale) const
+{
+    auto itr = strings.find(MakeKey(kind, entry, locale));
+    if (itr == strings.end())
+        return false;
+
+    lua_rawgeti(L, LUA_REGISTRYINDEX, itr->second.ref);
+    return true;
+}
+
+std::string const& ElunaStringCache::Insert(Kind kind, uint32 entry, uint8 locale, std::string const& value)
+{
+    if (strings.size() >= MAX_SIZE)
+        Clear();
+
+    uint64 key = MakeKey(kind, entry, locale);
+    auto itr = strings.find(key);
+    if (itr != strings.end())
+        return itr->second.value;
+
+    lua_pushlstring(L, value.c_str(), value.size());
+    int ref = ELUNA_REF(L, ELUNA_REF_STRING_CACHE);
+
+    return strings.emplace(key, CachedString{ value, ref }).first->second.value;
+}
+
+void ElunaStringCache::Clear()
+{
+    for (auto const& itr : strings)
+        ELUNA_UNREF(L, itr.second.ref);
+    strings.clear();
+}
@@ -0,0 +1,76 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_STRING_CACHE_H
+#define _ELUNA_STRING_CACHE_H
+
+#include "Common.h"
+
+#include <string>
+#include <unordered_map>
+
+struct lua_State;
+
+/*
+ * Per-state cache of chat links and localized names keyed by (kind, entry, locale).
+ *
+ * Each string is kept both as a C++ string, for building longer strings natively,
+ *   and as a Lua string referenced from the registry, so pushing a cached string
+ *   does not allocate or hash it again.
+ */
+class ElunaStringCache
+{
+public:
+    enum Kind
+    {
+        ITEM_LINK,
+        ITEM_NAME,
+        SPELL_LINK,
+        QUEST_LINK,
+        CREATURE_NAME
+    };
+
+    // The cache is cleared when it grows past this many strings
+    static const size_t MAX_SIZE = 65536;
+
+    ElunaStringCache(lua_State* L);
+    ~ElunaStringCache();
+
+    ElunaStringCache(ElunaStringCache const&) = delete;
+    ElunaStringCache& operator=(ElunaStringCache const&) = delete;
+
+    /*
+     * Returns the cached string or `nullptr` if it is not cached.
+     */
+    std::string const* Find(Kind kind, uint32 entry, uint8 locale) const;
+
+    /*
+     * Pushes the cached string on the stack. Returns `false` and pushes nothing if it is not cached.
+     */
+    bool Push(Kind kind, uint32 entry, uint8 locale) const;
+
+    /*
+     * Caches `value` and returns the cached copy.
+     */
+    std::string const& Insert(Kind kind, uint32 entry, uint8 locale, std::string const& value);
+
+    void Clear();
+    size_t GetSize() const { return strings.size(); }
+
+private:
+    struct CachedString
+    {
+        std::string value;
+        int ref;
+    };
+
+    static uint64 MakeKey(Kind kind, uint32 entry, uint8 locale) { return (uint64(kind) << 40) | (uint64(locale) << 32) | entry; }
+
+    lua_State* L;
+    std::unordered_map<uint64, CachedString> strings;
+};
+
+#endif
@@ -17,6 +17,9 @@ extern "C"
 #include "ElunaUtility.h"
 #include "ElunaCompat.h"
 #include "ElunaConfig.h"
+#include "ElunaAuctionSnapshot.h"
+#include "ElunaGossipMenu.h"
+#include "ElunaSpawnGroup.h"
 #include "ElunaSpellWrapper.h"
 #if !defined ELUNA_CMANGOS
 #include "SharedDefines.h"
@@ -29,29 +32,38 @@ extern "C"
 #include "UniqueTrackablePtr.h"
 #endif
 
+/*
+ * Header of every userdata pushed by ElunaTemplate.
+ *
+ * The layout is not virtual: the wrapped type is always known where an object
+ *   is checked or collected, so the typed ElunaObjectImpl<T> is used directly
+ *   and the kind tag only serves the few type independent operations.
+ */
 class ElunaObject
 {
 public:
-    ElunaObject(Eluna* E, char const* tname) : E(E), type_name(tname)
+    enum ObjectKind : uint8
     {
-    }
+        OBJECT_KIND_POINTER,    // raw pointer, valid for the callstack it was pushed in
+        OBJECT_KIND_WEAK,       // weak reference to a trackable core object
+        OBJECT_KIND_VALUE       // copy owned by Lua
+    };
 
-    virtual ~ElunaObject()
+    ElunaObject(char const* tname, ObjectKind kind) : type_name(tname), kind(kind)
     {
     }
 
-    // Get wrapped object pointer
-    virtual void* GetObjIfValid() const = 0;
     // Returns pointer to the wrapped object's type name
     const char* GetTypeName() const { return type_name; }
+    ObjectKind GetKind() const { return kind; }
 #if !defined TRACKABLE_PTR_NAMESPACE
     // Invalidates the pointer if it should be invalidated
-    virtual void Invalidate() = 0;
+    void Invalidate();
 #endif
 
 protected:
-    Eluna* E;
     const char* type_name;
+    ObjectKind kind;
 };
 
 #if defined TRACKABLE_PTR_NAMESPACE
@@ -85,61 +97,89 @@ ElunaConstrainedObjectRef<T> GetWeakPtrFor(T const* obj)
 
 #endif
 
-template <typename T>
-class ElunaObjectImpl : public ElunaObject
+#if !defined TRACKABLE_PTR_NAMESPACE
+class ElunaPointerObject : public ElunaObject
 {
 public:
-#if defined TRACKABLE_PTR_NAMESPACE
-    ElunaObjectImpl(Eluna* E, T const* obj, char const* tname) : ElunaObject(E, tname), _obj(GetWeakPtrFor(obj))
+    ElunaPointerObject(Eluna* E, void* obj, char const* tname) : ElunaObject(tname, OBJECT_KIND_POINTER), _obj(obj), callstackid(E->GetCallstackId())
     {
     }
 
-    void* GetObjIfValid() const override
+    void* GetObjIfValid(Eluna* E) const
     {
-        if (TRACKABLE_PTR_NAMESPACE unique_strong_ref_ptr<T> obj = _obj.Obj.lock())
-            if (!E->GetBoundMap() || !_obj.BoundMap || E->GetBoundMap() == _obj.BoundMap)
-                return obj.get();
+        if (callstackid == E->GetCallstackId())
+            return _obj;
 
         return nullptr;
     }
-#else
-    ElunaObjectImpl(Eluna* E, T* obj, char const* tname) : ElunaObject(E, tname), _obj(obj), callstackid(E->GetCallstackId())
+
+    void Invalidate() { callstackid = 1; }
+
+private:
+    void* _obj;
+    uint64 callstackid;
+};
+
+inline void ElunaObject::Invalidate()
+{
+    if (kind == OBJECT_KIND_POINTER)
+        static_cast<ElunaPointerObject*>(this)->Invalidate();
+}
+#endif
+
+#if defined TRACKABLE_PTR_NAMESPACE
+template <typename T>
+class ElunaObjectImpl : public ElunaObject
+{
+public:
+    ElunaObjectImpl(Eluna* /*E*/, T const* obj, char const* tname) : ElunaObject(tname, OBJECT_KIND_WEAK), _obj(GetWeakPtrFor(obj))
     {
     }
 
-    void* GetObjIfValid() const override
+    void* GetObjIfValid(Eluna* E) const
     {
-        if (callstackid == E->GetCallstackId())
-            return _obj;
+        // Already validated in this callstack, only check that the object was not destroyed since
+        if (validCallstackId == E->GetCallstackId() && !_obj.Obj.expired())
+            return validObj;
+
+        if (TRACKABLE_PTR_NAMESPACE unique_strong_ref_ptr<T> obj = _obj.Obj.lock())
+        {
+            if (!E->GetBoundMap() || !_obj.BoundMap || E->GetBoundMap() == _obj.BoundMap)
+            {
+                validObj = obj.get();
+                validCallstackId = E->GetCallstackId();
+                return validObj;
+            }
+        }
 
         return nullptr;
     }
 
-    void Invalidate() override { callstackid = 1; }
-#endif
-
 private:
-#if defined TRACKABLE_PTR_NAMESPACE
     ElunaConstrainedObjectRef<T> _obj;
+    mutable T* validObj = nullptr;
+    mutable uint64 validCallstackId = 1;
+};
 #else
-    void* _obj;
-    uint64 callstackid;
-#endif
+template <typename T>
+class ElunaObjectImpl : public ElunaPointerObject
+{
+public:
+    ElunaObjectImpl(Eluna* E, T* obj, char const* tname) : ElunaPointerObject(E, obj, tname)
+    {
+    }
 };
+#endif
 
 template <typename T>
 class ElunaObjectValueImpl : public ElunaObject
 {
 public:
-    ElunaObjectValueImpl(Eluna* E, T const* obj, char const* tname) : ElunaObject(E, tname), _obj(*obj /*always a copy, what gets passed here might be pointing to something not owned by us*/)
+    ElunaObjectValueImpl(Eluna* /*E*/, T const* obj, char const* tname) : ElunaObject(tname, OBJECT_KIND_VALUE), _obj(*obj /*always a copy, what gets passed here might be pointing to something not owned by us*/)
     {
     }
 
-    void* GetObjIfValid() const override { return const_cast<T*>(&_obj); }
-
-#if !defined TRACKABLE_PTR_NAMESPACE
-    void Invalidate() override { }
-#endif
+    void* GetObjIfValid(Eluna* /*E*/) const { return const_cast<T*>(&_obj); }
 
 private:
     T _obj;
@@ -159,6 +199,9 @@ MAKE_ELUNA_OBJECT_VALUE_IMPL(ObjectGuid);
 MAKE_ELUNA_OBJECT_VALUE_IMPL(WorldPacket);
 MAKE_ELUNA_OBJECT_VALUE_IMPL(ElunaQuery);
 MAKE_ELUNA_OBJECT_VALUE_IMPL(ElunaSpellInfo);
+MAKE_ELUNA_OBJECT_VALUE_IMPL(ElunaGossipMenu);
+MAKE_ELUNA_OBJECT_VALUE_IMPL(ElunaSpawnGroup);
+MAKE_ELUNA_OBJECT_VALUE_IMPL(ElunaAuctionSnapshot);
 
 template<typename T = void>
 struct ElunaRegister
@@ -219,9 +262,12 @@ public:
         lua_pushcfunction(L, ToString);
         lua_setfield(L, metatable, "__tostring");
 
-        // garbage collecting
-        lua_pushcfunction(L, CollectGarbage);
-        lua_setfield(L, metatable, "__gc");
+        // garbage collecting, objects without a destructor need no finalizer
+        if constexpr (!std::is_trivially_destructible_v<ElunaObjectImpl<T>>)
+        {
+            lua_pushcfunction(L, CollectGarbage);
+            lua_setfield(L, metatable, "__gc");
+        }
 
         // TODO: Safe to remove this?
         // make methods accessible through metatable
@@ -417,7 +463,7 @@ public:
         if (!elunaObj)
             return NULL;
 
-        void* obj = elunaObj->GetObjIfValid();
+        void* obj = static_cast<ElunaObjectImpl<T>*>(elunaObj)->GetObjIfValid(E);
         if (!obj)
         {
             char buff[256];
@@ -484,8 +530,9 @@ public:
         Eluna* E = Eluna::GetEluna(L);
 
         // Get object pointer (and check type, no error)
-        ElunaObject* obj = E->CHECKOBJ<ElunaObject>(1, false);
-        obj->~ElunaObject();
+        ElunaObjectImpl<T>* obj = static_cast<ElunaObjectImpl<T>*>(E->CHECKTYPE(1, tname, false));
+        if (obj)
+            obj->~ElunaObjectImpl<T>();
         return 0;
     }
 
@@ -20,6 +20,8 @@
 #include "Util/Timer.h"
 #endif
 
+#include <chrono>
+
 uint32 ElunaUtil::GetCurrTime()
 {
 #if defined ELUNA_TRINITY || defined ELUNA_MANGOS  || defined ELUNA_AZEROTHCORE
@@ -38,6 +40,11 @@ uint32 ElunaUtil::GetTimeDiff(uint32 oldMSTime)
 #endif
 }
 
+uint64 ElunaUtil::GetCurrTimeUs()
+{
+    return uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
 ElunaUtil::ObjectGUIDCheck::ObjectGUIDCheck(ObjectGuid guid) : _guid(guid)
 {
 }
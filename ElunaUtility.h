@@ -144,6 +144,9 @@ namespace ElunaUtil
 
     uint32 GetTimeDiff(uint32 oldMSTime);
 
+    // Monotonic time in microseconds, for measuring durations
+    uint64 GetCurrTimeUs();
+
     class ObjectGUIDCheck
     {
     public:
@@ -7,11 +7,21 @@
 #include "Hooks.h"
 #include "LuaEngine.h"
 #include "BindingMap.h"
+#include "ElunaChatFilter.h"
+#include "ElunaCommandMgr.h"
 #include "ElunaCompat.h"
 #include "ElunaConfig.h"
 #include "ElunaEventMgr.h"
 #include "ElunaIncludes.h"
 #include "ElunaLoader.h"
+#include "ElunaStringCache.h"
+#include "ElunaObjectVariables.h"
+#include "ElunaFFI.h"
+#include "ElunaHeapCensus.h"
+#include "ElunaHookTrace.h"
+#include "ElunaScriptProfiler.h"
+#include "ElunaSlowHandlers.h"
+#include "ElunaModuleApi.h"
 #include "ElunaTemplate.h"
 #include "ElunaUtility.h"
 #include "ElunaCreatureAI.h"
@@ -31,6 +41,8 @@ extern void RegisterMethods(Eluna* E);
 
 void Eluna::_ReloadEluna()
 {
+    uint64 traceStart = ElunaUtil::GetCurrTimeUs();
+
     // Remove all timed events
     eventMgr->SetAllEventStates(LUAEVENT_STATE_ERASE);
 
@@ -49,6 +61,17 @@ void Eluna::_ReloadEluna()
     RunScripts();
 
     reload = false;
+
+    if (chromeTrace)
+        chromeTrace->Complete("state", "reload", traceStart);
+}
+
+void Eluna::UpdateChromeTrace()
+{
+    if (!sElunaChromeTrace->IsActive())
+        chromeTrace.reset();
+    else if (!chromeTrace || chromeTrace->GetSession() != sElunaChromeTrace->GetSession())
+        chromeTrace = std::make_unique<ElunaChromeTrace::Recorder>(GetBoundMapId(), GetBoundInstanceId());
 }
 
 Eluna::Eluna(Map* map) :
@@ -57,6 +80,9 @@ push_counter(0),
 boundMap(map),
 L(NULL)
 {
+    if (sElunaConfig->IsMetricsExportEnabled())
+        metrics = std::make_unique<ElunaMetrics::Recorder>(this, sElunaConfig->GetConfig(CONFIG_ELUNA_METRICS_INTERVAL));
+
     OpenLua();
     eventMgr = std::make_unique<EventMgr>(this);
 
@@ -77,6 +103,30 @@ void Eluna::CloseLua()
     OnLuaStateClose();
 
     DestroyBindStores();
+    commandMgr.reset();
+    chatFilterMgr.reset();
+    stringCache.reset();
+    objectVariables.reset();
+    hookTrace.reset();
+    heapCensus.reset();
+    // Removes its hook from the state
+    slowHandlers.reset();
+    // Restores the allocator of the state, so it has to go before lua_close
+    scriptProfiler.reset();
+
+    if (refTracker)
+    {
+        // Timed events and continent and instance data are released along with the state
+        if (eventMgr)
+            eventMgr->UntrackRefs(refTracker.get());
+        for (auto const& ref : continentDataRefs)
+            refTracker->Remove(ref.second);
+        for (auto const& ref : instanceDataRefs)
+            refTracker->Remove(ref.second);
+
+        refTracker->ReportLeaks(GetBoundMapId(), GetBoundInstanceId());
+        refTracker.reset();
+    }
 
     // Must close lua state after deleting stores and mgr
     if (L)
@@ -93,20 +143,18 @@ static int PrecompiledLoader(lua_State* L)
     if (modname == NULL)
         return 0;
 
-    const std::vector<LuaScript>& scripts = sElunaLoader->GetLuaScripts();
-
-    auto it = std::find_if(scripts.begin(), scripts.end(), [modname](const LuaScript& script) { return script.filename == modname; });
-    if (it == scripts.end()) {
+    const LuaScript* script = sElunaLoader->GetLuaScript(modname);
+    if (!script) {
         lua_pushfstring(L, "\n\tno precompiled script '%s' found", modname);
         return 1;
     }
-    if (luaL_loadbuffer(L, reinterpret_cast<const char*>(&it->bytecode[0]), it->bytecode.size(), it->filename.c_str()))
+    if (luaL_loadbuffer(L, reinterpret_cast<const char*>(&script->bytecode[0]), script->bytecode.size(), script->filename.c_str()))
     {
         // Stack: modname, errmsg
         return lua_error(L);
     }
     // Stack: modname, filefunction
-    lua_pushstring(L, it->filepath.c_str());
+    lua_pushstring(L, script->filepath.c_str());
     // Stack: modname, filefunction, modpath
     return 2;
 }
@@ -118,13 +166,39 @@ void Eluna::OpenLua()
     lua_pushlightuserdata(L, this);
     lua_setfield(L, LUA_REGISTRYINDEX, ELUNA_STATE_PTR);
 
+#if defined ELUNA_REF_TRACKING
+    refTracker = std::make_unique<ElunaRefTracker>();
+#endif
+
     CreateBindStores();
+    commandMgr = std::make_unique<ElunaCommandMgr>(L);
+    chatFilterMgr = std::make_unique<ElunaChatFilterMgr>(L);
+    stringCache = std::make_unique<ElunaStringCache>(L);
+    objectVariables = std::make_unique<ElunaObjectVariables>(L);
+    UpdateChromeTrace();
+    if (sElunaConfig->IsScriptProfilingEnabled())
+        scriptProfiler = std::make_unique<ElunaScriptProfiler>(L, sElunaConfig->GetConfig(CONFIG_ELUNA_SCRIPT_PROFILING_LOG_INTERVAL));
+    if (sElunaConfig->IsSlowHandlerDetectionEnabled())
+        slowHandlers = std::make_unique<ElunaSlowHandlers>(this, sElunaConfig->GetConfig(CONFIG_ELUNA_SLOW_HANDLER_THRESHOLD),
+            sElunaConfig->GetConfig(CONFIG_ELUNA_SLOW_HANDLER_REPORT_INTERVAL), sElunaConfig->GetConfig(CONFIG_ELUNA_SLOW_HANDLER_TRACEBACK));
 
     // open base lua libraries
     luaL_openlibs(L);
 
     // Register methods and functions
     RegisterMethods(this);
+    ElunaFFI::Register(this);
+    ElunaModule::Register(this);
+
+#if !defined ELUNA_NATIVE_INT64
+    // Weak valued table of pushed GUIDs, so the same GUID is always the same userdata
+    lua_newtable(L);
+    lua_newtable(L);
+    lua_pushstring(L, "v");
+    lua_setfield(L, -2, "__mode");
+    lua_setmetatable(L, -2);
+    lua_setfield(L, LUA_REGISTRYINDEX, ELUNA_GUID_CACHE);
+#endif
 
     // Register event ID lookup table
     RegisterHookGlobals(L);
@@ -189,6 +263,14 @@ void Eluna::DestroyBindStores()
         binding.reset();
 }
 
+uint8 Eluna::GetBindingType(BaseBindingMap const* bindings) const
+{
+    for (uint8 i = 0; i < Hooks::REGTYPE_COUNT; ++i)
+        if (bindingMaps[i].get() == bindings)
+            return i;
+    return Hooks::REGTYPE_COUNT;
+}
+
 void Eluna::RegisterHookGlobals(lua_State* _L)
 {
     lua_newtable(_L); 
@@ -216,6 +298,7 @@ void Eluna::RunScripts()
     ELUNA_LOG_DEBUG("[Eluna]: Running scripts for state: %i, instance: %u", boundMapId, boundInstanceId);
 
     uint32 oldMSTime = ElunaUtil::GetCurrTime();
+    uint64 traceStart = ElunaUtil::GetCurrTimeUs();
     uint32 count = 0;
 
     std::unordered_map<std::string, std::string> loaded; // filename, path
@@ -225,32 +308,33 @@ void Eluna::RunScripts()
 
     const std::vector<LuaScript>& scripts = sElunaLoader->GetLuaScripts();
 
-    for (auto it = scripts.begin(); it != scripts.end(); ++it)
+    // the scripts that are either global or meant to be loaded for this map
+    for (uint32 index : sElunaLoader->GetMapScripts(boundMapId))
     {
-        // check that the script file is either global or meant to be loaded for this map
-        if (it->mapId != -1 && it->mapId != boundMapId)
-        {
-            ELUNA_LOG_DEBUG("[Eluna]: `%s` is tagged %i and will not load for map: %i", it->filename.c_str(), it->mapId, boundMapId);
-            continue;
-        }
+        const LuaScript* script = &scripts[index];
 
         // Check that no duplicate names exist
-        if (loaded.find(it->filename) != loaded.end())
+        if (loaded.find(script->filename) != loaded.end())
         {
-            ELUNA_LOG_ERROR("[Eluna]: Error loading `%s`. File with same name already loaded from `%s`, rename either file", it->filepath.c_str(), loaded[it->filename].c_str());
+            ELUNA_LOG_ERROR("[Eluna]: Error loading `%s`. File with same name already loaded from `%s`, rename either file", script->filepath.c_str(), loaded[script->filename].c_str());
             continue;
         }
-        loaded[it->filename] = it->filepath;
+        loaded[script->filename] = script->filepath;
 
         // We call require on the filename to load the script
         // A custom loader is used to load the script from the combined_scripts table
         // The loader is set up in Eluna::OpenLua
         lua_pushvalue(L, -1); // Stack: require, require
-        lua_pushstring(L, it->filename.c_str()); // Stack: require, require, filename
-        if (ExecuteCall(1, 0))
+        lua_pushstring(L, script->filename.c_str()); // Stack: require, require, filename
+        ElunaScriptProfiler::Scope profile(scriptProfiler.get(), scriptProfiler ? scriptProfiler->GetScriptId(script->filepath) : 0);
+        uint64 scriptStart = ElunaUtil::GetCurrTimeUs();
+        bool executed = ExecuteCall(1, 0);
+        if (chromeTrace)
+            chromeTrace->Complete("state", script->filename, scriptStart);
+        if (executed)
         {
             // Successfully called require on the script
-            ELUNA_LOG_DEBUG("[Eluna]: Successfully loaded `%s`", it->filepath.c_str());
+            ELUNA_LOG_DEBUG("[Eluna]: Successfully loaded `%s`", script->filepath.c_str());
             ++count;
             continue;
         }
@@ -259,17 +343,22 @@ void Eluna::RunScripts()
     // Stack: require
     lua_pop(L, 1);
     ELUNA_LOG_INFO("[Eluna]: Executed %u Lua scripts in %u ms for map: %i, instance: %u", count, ElunaUtil::GetTimeDiff(oldMSTime), boundMapId, boundInstanceId);
+    if (chromeTrace)
+        chromeTrace->Complete("state", "run scripts", traceStart, "\"scripts\":" + std::to_string(count));
 
     OnLuaStateOpen();
 }
 
-#if !defined TRACKABLE_PTR_NAMESPACE
+uint32 Eluna::GetActiveScriptId() const
+{
+    return scriptProfiler ? scriptProfiler->GetActiveScript() : ElunaScriptProfiler::UNKNOWN_SCRIPT;
+}
+
 void Eluna::InvalidateObjects()
 {
     ++callstackid;
     ASSERT(callstackid && "Callstackid overflow");
 }
-#endif
 
 void Eluna::Report(lua_State* _L)
 {
@@ -323,6 +412,16 @@ bool Eluna::ExecuteCall(int params, int res)
         ASSERT(false); // stack probably corrupt
     }
 
+    // A copy of the function is kept below it, so a slow call can tell which function it was
+    int function = 0;
+    if (slowHandlers)
+    {
+        lua_pushvalue(L, base);
+        lua_insert(L, base);
+        function = base++;
+        // Stack: function, function, [parameters]
+    }
+
     bool usetrace = sElunaConfig->GetConfig(CONFIG_ELUNA_TRACEBACK);
     if (usetrace)
     {
@@ -332,6 +431,10 @@ bool Eluna::ExecuteCall(int params, int res)
         // Stack: traceback, function, [parameters]
     }
 
+    ElunaSlowHandlers::Call call;
+    if (slowHandlers)
+        slowHandlers->Begin(call);
+
     // Objects are invalidated when event_level hits 0
     ++event_level;
     int result = lua_pcall(L, params, res, usetrace ? base : 0);
@@ -342,8 +445,18 @@ bool Eluna::ExecuteCall(int params, int res)
         // Stack: traceback, [results or errmsg]
         lua_remove(L, base);
     }
+
+    if (slowHandlers)
+    {
+        // Stack: function, [results or errmsg]
+        slowHandlers->End(call, function);
+        lua_remove(L, function);
+    }
     // Stack: [results or errmsg]
 
+    if (metrics)
+        metrics->OnCall(result != 0);
+
     // lua_pcall returns 0 on success.
     // On error print the error and push nils for expected amount of returned values
     if (result)
@@ -352,7 +465,12 @@ bool Eluna::ExecuteCall(int params, int res)
         Report(L);
 
         // Force garbage collect
+        uint64 traceStart = ElunaUtil::GetCurrTimeUs();
         lua_gc(L, LUA_GCCOLLECT, 0);
+        if (chromeTrace)
+            chromeTrace->Complete("gc", "full collection", traceStart);
+        if (metrics)
+            metrics->OnCollect(ElunaUtil::GetCurrTimeUs() - traceStart);
 
         // Push nils for expected amount of results
         for (int i = 0; i < res; ++i)
@@ -371,13 +489,22 @@ void Eluna::Push()
 }
 void Eluna::Push(const long long l)
 {
+#if defined ELUNA_NATIVE_INT64
+    lua_pushinteger(L, static_cast<lua_Integer>(l));
+#else
     // pushing pointer to local is fine, a copy of value will be stored, not pointer itself
     ElunaTemplate<long long>::Push(this, &l);
+#endif
 }
 void Eluna::Push(const unsigned long long l)
 {
+#if defined ELUNA_NATIVE_INT64
+    // values above 2^63 - 1 wrap around to negative integers, the bits are kept as they are
+    lua_pushinteger(L, static_cast<lua_Integer>(l));
+#else
     // pushing pointer to local is fine, a copy of value will be stored, not pointer itself
     ElunaTemplate<unsigned long long>::Push(this, &l);
+#endif
 }
 void Eluna::Push(const long l)
 {
@@ -494,8 +621,33 @@ void Eluna::Push(Object const* obj)
 }
 void Eluna::Push(ObjectGuid const guid)
 {
+#if defined ELUNA_NATIVE_INT64
+    // the raw value is pushed, so equal GUIDs are equal integers and can be used as table keys
+    lua_pushinteger(L, static_cast<lua_Integer>(guid.GetRawValue()));
+#else
+    // GUIDs are interned, equal GUIDs are the same userdata and can be used as table keys
+    uint64 raw = guid.GetRawValue();
+    lua_getfield(L, LUA_REGISTRYINDEX, ELUNA_GUID_CACHE);
+    lua_pushlstring(L, reinterpret_cast<const char*>(&raw), sizeof(raw));
+    lua_pushvalue(L, -1);
+    lua_rawget(L, -3);
+    // Stack: cache, key, guid or nil
+    if (!lua_isnil(L, -1))
+    {
+        lua_replace(L, -3);
+        lua_pop(L, 1);
+        return;
+    }
+    lua_pop(L, 1);
+
     // pushing pointer to local is fine, a copy of value will be stored, not pointer itself
     ElunaTemplate<ObjectGuid>::Push(this, &guid);
+    lua_pushvalue(L, -1);
+    lua_insert(L, -4);
+    // Stack: guid, cache, key, guid
+    lua_rawset(L, -3);
+    lua_pop(L, 1);
+#endif
 }
 
 static int CheckIntegerRange(lua_State* luastate, int narg, int min, int max)
@@ -581,15 +733,27 @@ template<> std::string Eluna::CHECKVAL<std::string>(int narg)
 }
 template<> long long Eluna::CHECKVAL<long long>(int narg)
 {
+#if defined ELUNA_NATIVE_INT64
+    if (lua_isinteger(L, narg))
+        return static_cast<long long>(lua_tointeger(L, narg));
+    return static_cast<long long>(CHECKVAL<double>(narg));
+#else
     if (lua_isnumber(L, narg))
         return static_cast<long long>(CHECKVAL<double>(narg));
     return *(Eluna::CHECKOBJ<long long>(narg, true));
+#endif
 }
 template<> unsigned long long Eluna::CHECKVAL<unsigned long long>(int narg)
 {
+#if defined ELUNA_NATIVE_INT64
+    if (lua_isinteger(L, narg))
+        return static_cast<unsigned long long>(lua_tointeger(L, narg));
+    return static_cast<unsigned long long>(CHECKVAL<uint32>(narg));
+#else
     if (lua_isnumber(L, narg))
         return static_cast<unsigned long long>(CHECKVAL<uint32>(narg));
     return *(Eluna::CHECKOBJ<unsigned long long>(narg, true));
+#endif
 }
 template<> long Eluna::CHECKVAL<long>(int narg)
 {
@@ -601,8 +765,12 @@ template<> unsigned long Eluna::CHECKVAL<unsigned long>(int narg)
 }
 template<> ObjectGuid Eluna::CHECKVAL<ObjectGuid>(int narg)
 {
+#if defined ELUNA_NATIVE_INT64
+    return ObjectGuid(static_cast<uint64>(luaL_checkinteger(L, narg)));
+#else
     ObjectGuid* guid = CHECKOBJ<ObjectGuid>(narg, true);
     return guid ? *guid : ObjectGuid();
+#endif
 }
 
 template<> Object* Eluna::CHECKOBJ<Object>(int narg, bool error)
@@ -696,7 +864,7 @@ int RegisterBasicBinding(Eluna* e, std::underlying_type_t<Hooks::RegisterTypes>
     typedef EventKey<K> Key;
     auto binding = e->GetBinding<Key>(regtype);
     auto key = Key(static_cast<K>(event_id));
-    uint64 bindingID = binding->Insert(key, functionRef, shots);
+    uint64 bindingID = binding->Insert(key, functionRef, shots, e->GetActiveScriptId());
     createCancelCallback(e, bindingID, binding);
     return 1; // Stack: callback
 }
@@ -707,7 +875,7 @@ int RegisterEntryBinding(Eluna* e, std::underlying_type_t<Hooks::RegisterTypes>
     typedef EntryKey<K> Key;
     auto binding = e->GetBinding<Key>(regtype);
     auto key = Key(static_cast<K>(event_id), entry);
-    uint64 bindingID = binding->Insert(key, functionRef, shots);
+    uint64 bindingID = binding->Insert(key, functionRef, shots, e->GetActiveScriptId());
     createCancelCallback(e, bindingID, binding);
     return 1; // Stack: callback
 }
@@ -718,7 +886,7 @@ int RegisterUniqueBinding(Eluna* e, std::underlying_type_t<Hooks::RegisterTypes>
     typedef UniqueObjectKey<K> Key;
     auto binding = e->GetBinding<Key>(regtype);
     auto key = Key(static_cast<K>(event_id), guid, instanceId);
-    uint64 bindingID = binding->Insert(key, functionRef, shots);
+    uint64 bindingID = binding->Insert(key, functionRef, shots, e->GetActiveScriptId());
     createCancelCallback(e, bindingID, binding);
     return 1; // Stack: callback
 }
@@ -763,7 +931,7 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
             {
                 if (entry >= NUM_MSG_TYPES)
                 {
-                    luaL_unref(L, LUA_REGISTRYINDEX, functionRef);
+                    ELUNA_UNREF(L, functionRef);
                     luaL_error(L, "Couldn't find a creature with (ID: %d)!", entry);
                     return 0; // Stack: (empty)
                 }
@@ -776,7 +944,7 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
             {
                 if (!eObjectMgr->GetCreatureTemplate(entry))
                 {
-                    luaL_unref(L, LUA_REGISTRYINDEX, functionRef);
+                    ELUNA_UNREF(L, functionRef);
                     luaL_error(L, "Couldn't find a creature with (ID: %d)!", entry);
                     return 0; // Stack: (empty)
                 }
@@ -789,7 +957,7 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
             {
                 if (guid.IsEmpty())
                 {
-                    luaL_unref(L, LUA_REGISTRYINDEX, functionRef);
+                    ELUNA_UNREF(L, functionRef);
                     luaL_error(L, "guid was 0!");
                     return 0; // Stack: (empty)
                 }
@@ -802,7 +970,7 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
             {
                 if (!eObjectMgr->GetCreatureTemplate(entry))
                 {
-                    luaL_unref(L, LUA_REGISTRYINDEX, functionRef);
+                    ELUNA_UNREF(L, functionRef);
                     luaL_error(L, "Couldn't find a creature with (ID: %d)!", entry);
                     return 0; // Stack: (empty)
                 }
@@ -815,7 +983,7 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
             {
                 if (!eObjectMgr->GetGameObjectTemplate(entry))
                 {
-                    luaL_unref(L, LUA_REGISTRYINDEX, functionRef);
+                    ELUNA_UNREF(L, functionRef);
                     luaL_error(L, "Couldn't find a gameobject with (ID: %d)!", entry);
                     return 0; // Stack: (empty)
                 }
@@ -828,7 +996,7 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
             {
                 if (!eObjectMgr->GetGameObjectTemplate(entry))
                 {
-                    luaL_unref(L, LUA_REGISTRYINDEX, functionRef);
+                    ELUNA_UNREF(L, functionRef);
                     luaL_error(L, "Couldn't find a gameobject with (ID: %d)!", entry);
                     return 0; // Stack: (empty)
                 }
@@ -846,7 +1014,7 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
             {
                 if (!eObjectMgr->GetItemTemplate(entry))
                 {
-                    luaL_unref(L, LUA_REGISTRYINDEX, functionRef);
+                    ELUNA_UNREF(L, functionRef);
                     luaL_error(L, "Couldn't find a item with (ID: %d)!", entry);
                     return 0; // Stack: (empty)
                 }
@@ -859,7 +1027,7 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
             {
                 if (!eObjectMgr->GetItemTemplate(entry))
                 {
-                    luaL_unref(L, LUA_REGISTRYINDEX, functionRef);
+                    ELUNA_UNREF(L, functionRef);
                     luaL_error(L, "Couldn't find a item with (ID: %d)!", entry);
                     return 0; // Stack: (empty)
                 }
@@ -878,7 +1046,7 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
                 return RegisterEntryBinding<Hooks::InstanceEvents>(this, regtype, entry, event_id, functionRef, shots);
             break;
     }
-    luaL_unref(L, LUA_REGISTRYINDEX, functionRef);
+    ELUNA_UNREF(L, functionRef);
     std::ostringstream oss;
     oss << "regtype " << static_cast<unsigned int>(regtype) << ", event " << event_id << ", entry " << entry << ", guid " <<
 #if defined ELUNA_TRINITY
@@ -893,6 +1061,8 @@ int Eluna::Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32
 
 void Eluna::UpdateEluna(uint32 diff)
 {
+    UpdateChromeTrace();
+
     if (reload && sElunaLoader->GetCacheState() == SCRIPT_CACHE_READY)
 #if defined ELUNA_TRINITY
         if (GetQueryProcessor().Empty())
@@ -903,6 +1073,19 @@ void Eluna::UpdateEluna(uint32 diff)
 #if defined ELUNA_TRINITY
     GetQueryProcessor().ProcessReadyCallbacks();
 #endif
+
+    if (scriptProfiler)
+        scriptProfiler->Update(diff, GetBoundMapId(), GetBoundInstanceId());
+    if (metrics)
+        metrics->Update(diff);
+
+    if (chromeTrace)
+    {
+        // Lua collects incrementally during allocations, so the heap size over time is what shows its work
+        int heap = lua_gc(L, LUA_GCCOUNT, 0) * 1024 + lua_gc(L, LUA_GCCOUNTB, 0);
+        chromeTrace->Counter("lua heap", "\"bytes\":" + std::to_string(heap));
+        chromeTrace->Update(diff);
+    }
 }
 
 /*
@@ -915,10 +1098,24 @@ void Eluna::CleanUpStack(int number_of_arguments)
     lua_pop(L, number_of_arguments + 1); // Add 1 because the caller doesn't know about `event_id`.
     // Stack: (empty)
 
-#if !defined TRACKABLE_PTR_NAMESPACE
+    if (hookTrace)
+        hookTrace->EndHook();
+    if (slowHandlers)
+        slowHandlers->PopHook();
+    if (chromeTrace)
+        chromeTrace->EndHook();
+    if (metrics)
+        metrics->EndHook();
+
+    // Handlers that were not called, like the ones after a handler that ended the hook, are dropped
+    if (scriptProfiler && !handlerScriptBases.empty())
+    {
+        handlerScripts.resize(handlerScriptBases.back());
+        handlerScriptBases.pop_back();
+    }
+
     if (event_level == 0)
         InvalidateObjects();
-#endif
 }
 
 /*
@@ -944,10 +1141,39 @@ int Eluna::CallOneFunction(int number_of_functions, int number_of_arguments, int
     }
     // Stack: event_id, [arguments], [functions], event_id, [arguments]
 
+    uint32 scriptId = ElunaScriptProfiler::UNKNOWN_SCRIPT;
+    if (scriptProfiler)
+    {
+        ASSERT(!handlerScriptBases.empty() && handlerScripts.size() > handlerScriptBases.back());
+        scriptId = handlerScripts.back();
+        handlerScripts.pop_back();
+    }
+    ElunaScriptProfiler::Scope profile(scriptProfiler.get(), scriptId);
+
+    if (slowHandlers)
+        slowHandlers->SetHandlerCall();
+
+    std::string traceName;
+    uint64 traceStart = 0;
+    if (chromeTrace)
+    {
+        lua_Debug ar;
+        lua_pushvalue(L, functions_top);
+        lua_getinfo(L, ">S", &ar);
+        traceName = std::string(ar.short_src) + ":" + std::to_string(ar.linedefined);
+        traceStart = ElunaUtil::GetCurrTimeUs();
+    }
+
+    uint64 startTime = hookTrace ? ElunaUtil::GetCurrTimeUs() : 0;
     ExecuteCall(number_of_arguments, number_of_results);
     --functions_top;
     // Stack: event_id, [arguments], [functions - 1], [results]
 
+    if (hookTrace)
+        hookTrace->RecordResult(ElunaUtil::GetCurrTimeUs() - startTime, functions_top + 1, number_of_results);
+    if (chromeTrace)
+        chromeTrace->Complete("handler", traceName, traceStart);
+
     return functions_top + 1; // Return the location of the first result (if any exist).
 }
 
@@ -1006,7 +1232,7 @@ bool Eluna::HasInstanceData(Map const* map)
 void Eluna::CreateInstanceData(Map const* map)
 {
     ASSERT(lua_istable(L, -1));
-    int ref = luaL_ref(L, LUA_REGISTRYINDEX);
+    int ref = ELUNA_REF(L, ELUNA_REF_INSTANCE_DATA);
 
     if (!map->Instanceable())
     {
@@ -1016,7 +1242,7 @@ void Eluna::CreateInstanceData(Map const* map)
         auto mapRef = continentDataRefs.find(mapId);
         if (mapRef != continentDataRefs.end())
         {
-            luaL_unref(L, LUA_REGISTRYINDEX, mapRef->second);
+            ELUNA_UNREF(L, mapRef->second);
         }
 
         continentDataRefs[mapId] = ref;
@@ -1029,7 +1255,7 @@ void Eluna::CreateInstanceData(Map const* map)
         auto instRef = instanceDataRefs.find(instanceId);
         if (instRef != instanceDataRefs.end())
         {
-            luaL_unref(L, LUA_REGISTRYINDEX, instRef->second);
+            ELUNA_UNREF(L, instRef->second);
         }
 
         instanceDataRefs[instanceId] = ref;
@@ -1059,7 +1285,7 @@ void Eluna::FreeInstanceId(uint32 instanceId)
 
         if (instanceDataRefs.find(instanceId) != instanceDataRefs.end())
         {
-            luaL_unref(L, LUA_REGISTRYINDEX, instanceDataRefs[instanceId]);
+            ELUNA_UNREF(L, instanceDataRefs[instanceId]);
             instanceDataRefs.erase(instanceId);
         }
     }
@@ -37,6 +37,9 @@
 #include <mutex>
 #include <memory>
 #include "ElunaSpellWrapper.h"
+#include "ElunaRefTracker.h"
+#include "ElunaChromeTrace.h"
+#include "ElunaMetrics.h"
 
 extern "C"
 {
@@ -109,6 +112,15 @@ typedef VehicleInfo Vehicle;
 
 struct lua_State;
 class EventMgr;
+class ElunaCommandMgr;
+class ElunaChatFilterMgr;
+class ElunaStringCache;
+class ElunaObjectVariables;
+class ElunaBenchmark;
+class ElunaHookTrace;
+class ElunaScriptProfiler;
+class ElunaHeapCensus;
+class ElunaSlowHandlers;
 class ElunaObject;
 class BaseBindingMap;
 template<typename T> class ElunaTemplate;
@@ -144,6 +156,7 @@ enum MethodFlags : uint32
 };
 
 #define ELUNA_STATE_PTR "Eluna State Ptr"
+#define ELUNA_GUID_CACHE "Eluna GUID Cache"
 
 #if defined ELUNA_TRINITY
 #define ELUNA_GAME_API TC_GAME_API
@@ -159,6 +172,10 @@ enum MethodFlags : uint32
 
 class ELUNA_GAME_API Eluna
 {
+    // Drive the hook helpers directly to measure and replay hooks
+    friend class ElunaBenchmark;
+    friend class ElunaHookTrace;
+
 public:
 
     void ReloadEluna() { reload = true; }
@@ -169,13 +186,12 @@ private:
     // Indicates that the lua state should be reloaded
     bool reload = false;
 
-#if !defined TRACKABLE_PTR_NAMESPACE
     // A counter for lua event stacks that occur (see event_level).
-    // This is used to determine whether an object belongs to the current call stack or not.
+    // This is used to determine whether an object belongs to the current call stack or not,
+    // with trackable pointers it tags weak references already validated in the current call stack.
     // 0 is reserved for always belonging to the call stack
     // 1 is reserved for a non valid callstackid
     uint64 callstackid = 2;
-#endif
     // A counter for the amount of nested events. When the event_level
     // reaches 0 we are about to return back to C++. At this point the
     // objects used during the event stack are invalidated.
@@ -183,6 +199,10 @@ private:
     // When a hook pushes arguments to be passed to event handlers,
     //  this is used to keep track of how many arguments were pushed.
     uint8 push_counter;
+    // Scripts of the handlers pushed by SetupStack while script profiling, the last one is called first
+    std::vector<uint32> handlerScripts;
+    // Size of handlerScripts before each hook in progress pushed its handlers, restored by CleanUpStack
+    std::vector<size_t> handlerScriptBases;
 
     Map* const boundMap;
 
@@ -205,14 +225,21 @@ private:
     void DestroyBindStores();
     void CreateBindStores();
     void RegisterHookGlobals(lua_State* _L);
-#if !defined TRACKABLE_PTR_NAMESPACE
     void InvalidateObjects();
-#endif
+    // Returns the registration type of `bindings`, or REGTYPE_COUNT if it is not one of the state's binding maps
+    uint8 GetBindingType(BaseBindingMap const* bindings) const;
+
+    // Runs the chat filters attached to `event`, see RegisterChatFilter
+    template<typename T>
+    bool OnChatFilter(Hooks::PlayerEvents event, Player* pPlayer, uint32 type, uint32 lang, std::string& msg, T target);
 
     // Use ReloadEluna() to make eluna reload
     // This is called on world update to reload eluna
     void _ReloadEluna();
 
+    // Creates, replaces or removes the state's Chrome trace recorder to match the running trace
+    void UpdateChromeTrace();
+
     // Some helpers for hooks to call event handlers.
     // The bodies of the templates are in HookHelpers.h, so if you want to use them you need to #include "HookHelpers.h".
     template<typename K1, typename K2> int SetupStack(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, const K1& key1, const K2& key2, int number_of_arguments);
@@ -277,6 +304,17 @@ public:
 
     lua_State* L;
     std::unique_ptr<EventMgr> eventMgr;
+    std::unique_ptr<ElunaCommandMgr> commandMgr;
+    std::unique_ptr<ElunaChatFilterMgr> chatFilterMgr;
+    std::unique_ptr<ElunaStringCache> stringCache;
+    std::unique_ptr<ElunaObjectVariables> objectVariables;
+    std::unique_ptr<ElunaHookTrace> hookTrace;     // only set while hook calls are recorded, see StartHookTrace
+    std::unique_ptr<ElunaScriptProfiler> scriptProfiler;   // only set when Eluna.ScriptProfiling is enabled
+    std::unique_ptr<ElunaHeapCensus> heapCensus;   // previous census the next one is compared to, see GetHeapCensus
+    std::unique_ptr<ElunaSlowHandlers> slowHandlers;   // only set when Eluna.SlowHandlerThreshold is set
+    std::unique_ptr<ElunaRefTracker> refTracker;   // only set when ELUNA_REF_TRACKING is defined
+    std::unique_ptr<ElunaChromeTrace::Recorder> chromeTrace;   // only set while a Chrome trace is written, see StartChromeTrace
+    std::unique_ptr<ElunaMetrics::Recorder> metrics;   // only set when Eluna.MetricsFile is set, kept over reloads
 
 #if defined ELUNA_TRINITY || defined ELUNA_AZEROTHCORE
     QueryCallbackProcessor& GetQueryProcessor() { return queryProcessor; }
@@ -348,9 +386,9 @@ public:
 
     void RunScripts();
     bool HasLuaState() const { return L != NULL; }
-#if !defined TRACKABLE_PTR_NAMESPACE
     uint64 GetCallstackId() const { return callstackid; }
-#endif
+    // Script file whose code is running, 0 when unknown or script profiling is disabled
+    uint32 GetActiveScriptId() const;
     int Register(std::underlying_type_t<Hooks::RegisterTypes> regtype, uint32 entry, ObjectGuid guid, uint32 instanceId, uint32 event_id, int functionRef, uint32 shots);
     void UpdateEluna(uint32 diff);
 
@@ -415,7 +453,7 @@ public:
     Eluna& operator=(const Eluna&) = delete;
 
     /* Custom */
-    void OnTimedEvent(int funcRef, uint32 delay, uint32 calls, WorldObject* obj);
+    void OnTimedEvent(int funcRef, uint32 delay, uint32 calls, WorldObject* obj, uint32 scriptId);
     bool OnCommand(Player* player, const char* text);
     void OnWorldUpdate(uint32 diff);
     void OnLootItem(Player* pPlayer, Item* pItem, uint32 count, ObjectGuid guid);
@@ -8,6 +8,8 @@
 #define _HOOK_HELPERS_H
 
 #include "LuaEngine.h"
+#include "ElunaHookTrace.h"
+#include "ElunaSlowHandlers.h"
 #include "ElunaUtility.h"
 
 template<typename T>
@@ -71,6 +73,26 @@ int Eluna::SetupStack(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, cons
     ASSERT(key1.event_id == key2.event_id);
     // Stack: [arguments]
 
+    if (hookTrace || slowHandlers || chromeTrace)
+    {
+        ElunaHookTrace::Key traceKey = { GetBindingType(bindings1), Hooks::REGTYPE_COUNT, 0, 0, 0, 0 };
+        ElunaHookTrace::SetKey(traceKey, key1);
+        if (bindings2)
+        {
+            traceKey.uniqueRegtype = GetBindingType(bindings2);
+            ElunaHookTrace::SetKey(traceKey, key2);
+        }
+
+        if (hookTrace)
+            hookTrace->RecordHook(traceKey, event_level, lua_gettop(L) - number_of_arguments + 1, number_of_arguments);
+        if (slowHandlers)
+            slowHandlers->PushHook(traceKey);
+        if (chromeTrace)
+            chromeTrace->BeginHook(traceKey.regtype, traceKey.event, traceKey.entry);
+    }
+    if (metrics)
+        metrics->BeginHook();
+
     HookPush(key1.event_id);
     this->push_counter = 0;
     ++number_of_arguments;
@@ -83,9 +105,15 @@ int Eluna::SetupStack(BindingMap<K1>* bindings1, BindingMap<K2>* bindings2, cons
     lua_insert(L, first_argument_index);
     // Stack: event_id, [arguments]
 
-    bindings1->PushRefsFor(key1);
+    std::vector<uint32>* scriptIds = nullptr;
+    if (scriptProfiler)
+    {
+        handlerScriptBases.push_back(handlerScripts.size());
+        scriptIds = &handlerScripts;
+    }
+    bindings1->PushRefsFor(key1, scriptIds);
     if (bindings2)
-        bindings2->PushRefsFor(key2);
+        bindings2->PushRefsFor(key2, scriptIds);
     // Stack: event_id, [arguments], [functions]
 
     int number_of_functions = lua_gettop(L) - arguments_top;
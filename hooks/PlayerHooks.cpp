@@ -8,10 +8,13 @@
 #include "HookHelpers.h"
 #include "LuaEngine.h"
 #include "BindingMap.h"
+#include "ElunaChatFilter.h"
+#include "ElunaCommandMgr.h"
+#include "ElunaObjectVariables.h"
 #include "ElunaIncludes.h"
 #include "ElunaTemplate.h"
 #include "ElunaLoader.h"
-#include <algorithm> // std::transform
+#include <algorithm> // std::transform, std::find_if
 #include <cstdlib> // strtol
 
 using namespace Hooks;
@@ -93,6 +96,73 @@ bool Eluna::OnCommand(Player* player, const char* text)
         }
     }
 
+    // Commands registered with RegisterCommand are dispatched directly to their handler
+    size_t argsBegin = 0;
+    ElunaCommand const* command = commandMgr ? commandMgr->Find(text, argsBegin) : nullptr;
+    if (command && (!player || uint32(player->GetSession()->GetSecurity()) >= command->security))
+    {
+        std::vector<ElunaCommandValue> values;
+        std::string error;
+        if (!ElunaCommandMgr::ParseArgs(*command, text + argsBegin, values, error))
+        {
+            std::string message = "Usage: ." + ElunaCommandMgr::GetUsage(*command) + " (" + error + ")";
+            if (player)
+                ChatHandler(player->GetSession()).SendSysMessage(message.c_str());
+            else
+                ELUNA_LOG_INFO("[Eluna]: %s", message.c_str());
+            return false;
+        }
+
+        std::vector<Player*> players(values.size(), nullptr);
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (values[i].type != COMMAND_ARG_PLAYER || !values[i].present)
+                continue;
+
+            players[i] = eObjectAccessor()FindPlayerByName(values[i].text.c_str());
+            if (!players[i])
+            {
+                std::string message = "Player " + values[i].text + " not found";
+                if (player)
+                    ChatHandler(player->GetSession()).SendSysMessage(message.c_str());
+                else
+                    ELUNA_LOG_INFO("[Eluna]: %s", message.c_str());
+                return false;
+            }
+        }
+
+        lua_rawgeti(L, LUA_REGISTRYINDEX, command->functionReference);
+        Push(player);
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            ElunaCommandValue const& value = values[i];
+            if (!value.present)
+            {
+                Push();
+                continue;
+            }
+
+            switch (value.type)
+            {
+                case COMMAND_ARG_PLAYER:
+                    Push(players[i]);
+                    break;
+                case COMMAND_ARG_STRING:
+                case COMMAND_ARG_REST:
+                    Push(value.text);
+                    break;
+                default:
+                    Push(value.number);
+                    break;
+            }
+        }
+        ExecuteCall(int(values.size()) + 1, 0);
+
+        if (event_level == 0)
+            InvalidateObjects();
+        return false;
+    }
+
     START_HOOK_WITH_RETVAL(PLAYER_EVENT_ON_COMMAND, true);
     HookPush(player);
     HookPush(text);
@@ -423,6 +493,8 @@ void Eluna::OnLogin(Player* pPlayer)
 
 void Eluna::OnLogout(Player* pPlayer)
 {
+    objectVariables->Remove({ ElunaObjectVariables::PLAYER_MAP_ID, 0, pPlayer->GET_GUID().GetRawValue() });
+
     START_HOOK(PLAYER_EVENT_ON_LOGOUT);
     HookPush(pPlayer);
     CallAllFunctions(binding, key);
@@ -524,11 +596,80 @@ void Eluna::OnDiscoverArea(Player* player, uint32 area)
     CallAllFunctions(binding, key);
 }
 
+template<typename T>
+bool Eluna::OnChatFilter(Hooks::PlayerEvents event, Player* pPlayer, uint32 type, uint32 lang, std::string& msg, T target)
+{
+    if (!chatFilterMgr || !chatFilterMgr->HasFiltersFor(event))
+        return true;
+
+    uint32 mask = ElunaChatFilterMgr::GetEventMask(event);
+
+    // Handlers may remove filters, so look them up by id on every iteration
+    std::vector<uint64> ids;
+    for (auto const& filter : chatFilterMgr->GetFilters())
+        if (filter->events & mask)
+            ids.push_back(filter->id);
+
+    std::vector<ChatFilterMatch> matches;
+    for (uint64 id : ids)
+    {
+        auto const& filters = chatFilterMgr->GetFilters();
+        auto it = std::find_if(filters.begin(), filters.end(), [id](std::unique_ptr<ElunaChatFilterMgr::Filter> const& filter) { return filter->id == id; });
+        if (it == filters.end())
+            continue;
+
+        ElunaChatFilterMgr::Filter const& filter = **it;
+        matches.clear();
+        if (!filter.automaton.Search(msg, matches))
+            continue;
+
+        lua_rawgeti(L, LUA_REGISTRYINDEX, filter.functionReference);
+        Push(uint32(event));
+        Push(pPlayer);
+        Push(msg);
+
+        lua_createtable(L, int(matches.size()), 0);
+        for (size_t i = 0; i < matches.size(); ++i)
+        {
+            lua_createtable(L, 0, 3);
+            Push(uint32(matches[i].begin + 1));
+            lua_setfield(L, -2, "start");
+            Push(uint32(matches[i].end));
+            lua_setfield(L, -2, "stop");
+            Push(filter.automaton.GetWord(matches[i].word));
+            lua_setfield(L, -2, "word");
+            lua_rawseti(L, -2, int(i + 1));
+        }
+
+        Push(type);
+        Push(lang);
+        Push(target);
+
+        ExecuteCall(7, 2);
+
+        bool result = !(lua_isboolean(L, -2) && !lua_toboolean(L, -2));
+        if (lua_isstring(L, -1))
+            msg = std::string(lua_tostring(L, -1));
+
+        lua_pop(L, 2);
+
+        if (event_level == 0)
+            InvalidateObjects();
+        if (!result)
+            return false;
+    }
+
+    return true;
+}
+
 bool Eluna::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg)
 {
     if (lang == LANG_ADDON)
         return OnAddonMessage(pPlayer, type, msg, NULL, NULL, NULL, NULL);
 
+    if (!OnChatFilter(PLAYER_EVENT_ON_CHAT, pPlayer, type, lang, msg, static_cast<Player*>(nullptr)))
+        return false;
+
     START_HOOK_WITH_RETVAL(PLAYER_EVENT_ON_CHAT, true);
     bool result = true;
     HookPush(pPlayer);
@@ -559,6 +700,9 @@ bool Eluna::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg,
     if (lang == LANG_ADDON)
         return OnAddonMessage(pPlayer, type, msg, NULL, NULL, pGroup, NULL);
 
+    if (!OnChatFilter(PLAYER_EVENT_ON_GROUP_CHAT, pPlayer, type, lang, msg, pGroup))
+        return false;
+
     START_HOOK_WITH_RETVAL(PLAYER_EVENT_ON_GROUP_CHAT, true);
     bool result = true;
     HookPush(pPlayer);
@@ -590,6 +734,9 @@ bool Eluna::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg,
     if (lang == LANG_ADDON)
         return OnAddonMessage(pPlayer, type, msg, NULL, pGuild, NULL, NULL);
 
+    if (!OnChatFilter(PLAYER_EVENT_ON_GUILD_CHAT, pPlayer, type, lang, msg, pGuild))
+        return false;
+
     START_HOOK_WITH_RETVAL(PLAYER_EVENT_ON_GUILD_CHAT, true);
     bool result = true;
     HookPush(pPlayer);
@@ -621,6 +768,9 @@ bool Eluna::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg,
     if (lang == LANG_ADDON)
         return OnAddonMessage(pPlayer, type, msg, NULL, NULL, NULL, pChannel);
 
+    if (!OnChatFilter(PLAYER_EVENT_ON_CHANNEL_CHAT, pPlayer, type, lang, msg, pChannel->GetChannelId()))
+        return false;
+
     START_HOOK_WITH_RETVAL(PLAYER_EVENT_ON_CHANNEL_CHAT, true);
     bool result = true;
     HookPush(pPlayer);
@@ -652,6 +802,9 @@ bool Eluna::OnChat(Player* pPlayer, uint32 type, uint32 lang, std::string& msg,
     if (lang == LANG_ADDON)
         return OnAddonMessage(pPlayer, type, msg, pReceiver, NULL, NULL, NULL);
 
+    if (!OnChatFilter(PLAYER_EVENT_ON_WHISPER, pPlayer, type, lang, msg, pReceiver))
+        return false;
+
     START_HOOK_WITH_RETVAL(PLAYER_EVENT_ON_WHISPER, true);
     bool result = true;
     HookPush(pPlayer);
@@ -9,6 +9,8 @@
 #include "LuaEngine.h"
 #include "BindingMap.h"
 #include "ElunaEventMgr.h"
+#include "ElunaObjectVariables.h"
+#include "ElunaScriptProfiler.h"
 #include "ElunaIncludes.h"
 #include "ElunaTemplate.h"
 
@@ -60,9 +62,11 @@ bool Eluna::OnAddonMessage(Player* sender, uint32 type, std::string& msg, Player
     return CallAllFunctionsBool(binding, key, true);
 }
 
-void Eluna::OnTimedEvent(int funcRef, uint32 delay, uint32 calls, WorldObject* obj)
+void Eluna::OnTimedEvent(int funcRef, uint32 delay, uint32 calls, WorldObject* obj, uint32 scriptId)
 {
     ASSERT(!event_level);
+    ElunaScriptProfiler::Scope profile(scriptProfiler.get(), scriptId);
+    uint64 traceStart = ElunaUtil::GetCurrTimeUs();
 
     // Get function
     lua_rawgeti(L, LUA_REGISTRYINDEX, funcRef);
@@ -76,10 +80,13 @@ void Eluna::OnTimedEvent(int funcRef, uint32 delay, uint32 calls, WorldObject* o
     // Call function
     ExecuteCall(4, 0);
 
+    if (chromeTrace)
+        chromeTrace->Complete("timed_event", "timed event", traceStart, "\"id\":" + std::to_string(funcRef));
+    if (metrics)
+        metrics->OnTimedEvent();
+
     ASSERT(!event_level);
-#if !defined TRACKABLE_PTR_NAMESPACE
     InvalidateObjects();
-#endif
 }
 
 void Eluna::OnGameEventStart(uint32 eventid)
@@ -310,6 +317,8 @@ void Eluna::OnShutdown()
 /* Map */
 void Eluna::OnCreate(Map* map)
 {
+    objectVariables->RemoveMap(map->GetId(), map->GetInstanceId());
+
     START_HOOK(MAP_EVENT_ON_CREATE);
     HookPush(map);
     CallAllFunctions(binding, key);
@@ -317,6 +326,8 @@ void Eluna::OnCreate(Map* map)
 
 void Eluna::OnDestroy(Map* map)
 {
+    objectVariables->RemoveMap(map->GetId(), map->GetInstanceId());
+
     START_HOOK(MAP_EVENT_ON_DESTROY);
     HookPush(map);
     CallAllFunctions(binding, key);
@@ -348,6 +359,8 @@ void Eluna::OnMapUpdate(Map* map, uint32 diff)
 
 void Eluna::OnRemove(GameObject* gameobject)
 {
+    objectVariables->Remove({ gameobject->GetMapId(), gameobject->GetInstanceId(), gameobject->GET_GUID().GetRawValue() });
+
     START_HOOK(WORLD_EVENT_ON_DELETE_GAMEOBJECT);
     HookPush(gameobject);
     CallAllFunctions(binding, key);
@@ -355,6 +368,8 @@ void Eluna::OnRemove(GameObject* gameobject)
 
 void Eluna::OnRemove(Creature* creature)
 {
+    objectVariables->Remove({ creature->GetMapId(), creature->GetInstanceId(), creature->GET_GUID().GetRawValue() });
+
     START_HOOK(WORLD_EVENT_ON_DELETE_CREATURE);
     HookPush(creature);
     CallAllFunctions(binding, key);
@@ -0,0 +1,241 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef GOSSIPMENUMETHODS_H
+#define GOSSIPMENUMETHODS_H
+
+/***
+ * A gossip menu that is built once and can then be sent to any number of players with a single call.
+ *
+ * Items can have conditions, such as a level range or a rewarded quest. Conditions are checked natively
+ *   for each player the menu is sent to and items whose conditions are not met are left out of the menu.
+ *
+ * Created with [Global:CreateGossipMenu].
+ *
+ * Inherits all methods from: none
+ */
+namespace LuaGossipMenu
+{
+    static void ReadCondition(Eluna* E, int index, ElunaGossipCondition& condition)
+    {
+        lua_getfield(E->L, index, "minLevel");
+        condition.minLevel = E->CHECKVAL<uint32>(-1, 0);
+        lua_getfield(E->L, index, "maxLevel");
+        condition.maxLevel = E->CHECKVAL<uint32>(-1, 0);
+        lua_getfield(E->L, index, "classMask");
+        condition.classMask = E->CHECKVAL<uint32>(-1, 0);
+        lua_getfield(E->L, index, "raceMask");
+        condition.raceMask = E->CHECKVAL<uint32>(-1, 0);
+        lua_getfield(E->L, index, "team");
+        condition.team = E->CHECKVAL<int32>(-1, -1);
+        lua_getfield(E->L, index, "security");
+        condition.security = E->CHECKVAL<uint32>(-1, 0);
+        lua_getfield(E->L, index, "questRewarded");
+        condition.questRewarded = E->CHECKVAL<uint32>(-1, 0);
+        lua_getfield(E->L, index, "questNotRewarded");
+        condition.questNotRewarded = E->CHECKVAL<uint32>(-1, 0);
+        lua_getfield(E->L, index, "item");
+        condition.item = E->CHECKVAL<uint32>(-1, 0);
+        lua_getfield(E->L, index, "money");
+        condition.money = E->CHECKVAL<uint32>(-1, 0);
+        lua_pop(E->L, 10);
+    }
+
+    static bool IsConditionMet(Player* player, ElunaGossipCondition const& condition)
+    {
+        if (condition.minLevel && player->GetLevel() < condition.minLevel)
+            return false;
+        if (condition.maxLevel && player->GetLevel() > condition.maxLevel)
+            return false;
+        if (condition.classMask && !(player->getClassMask() & condition.classMask))
+            return false;
+        if (condition.raceMask && !(player->getRaceMask() & condition.raceMask))
+            return false;
+        if (condition.team >= 0 && int32(player->GetTeamId()) != condition.team)
+            return false;
+        if (condition.security && uint32(player->GetSession()->GetSecurity()) < condition.security)
+            return false;
+        if (condition.questRewarded && !player->GetQuestRewardStatus(condition.questRewarded))
+            return false;
+        if (condition.questNotRewarded && player->GetQuestRewardStatus(condition.questNotRewarded))
+            return false;
+        if (condition.item && !player->HasItemCount(condition.item, 1, false))
+            return false;
+        if (condition.money && player->GetMoney() < condition.money)
+            return false;
+        return true;
+    }
+
+    /**
+     * Adds an item to the [ElunaGossipMenu].
+     *
+     * The arguments are the same as for [Player:GossipMenuAddItem], with an optional table of conditions.
+     * An item with conditions is only shown to players that meet all of them.
+     *
+     * @table
+     * @columns [Condition, Type, Comment]
+     * @values [minLevel, uint32, "Minimum level"]
+     * @values [maxLevel, uint32, "Maximum level"]
+     * @values [classMask, uint32, "Mask of allowed classes"]
+     * @values [raceMask, uint32, "Mask of allowed races"]
+     * @values [team, uint32, "0 for Alliance or 1 for Horde"]
+     * @values [security, uint32, "Minimum account security level"]
+     * @values [questRewarded, uint32, "Quest that must be rewarded"]
+     * @values [questNotRewarded, uint32, "Quest that must not be rewarded"]
+     * @values [item, uint32, "Item that must be in the inventory"]
+     * @values [money, uint32, "Minimum money in copper"]
+     *
+     *     local menu = CreateGossipMenu(100)
+     *     menu:AddItem(0, "Teleport to Dalaran", 1, 1, false, nil, 0, { minLevel = 68 })
+     *
+     * @param uint32 icon : number that specifies used icon
+     * @param string msg : label on the gossip item
+     * @param uint32 sender : number passed to gossip handlers
+     * @param uint32 intid : number passed to gossip handlers
+     * @param bool code = false : show text input on click if true
+     * @param string popup = nil : if non empty string, a popup with given text shown on click
+     * @param uint32 money = 0 : required money in copper
+     * @param table conditions = nil : conditions the player has to meet to see the item, refer to the table above
+     * @return uint32 count : amount of items in the menu
+     */
+    int AddItem(Eluna* E, ElunaGossipMenu* menu)
+    {
+        ElunaGossipMenuItem item;
+        item.icon = E->CHECKVAL<uint32>(2);
+        item.text = E->CHECKVAL<std::string>(3);
+        item.sender = E->CHECKVAL<uint32>(4);
+        item.intid = E->CHECKVAL<uint32>(5);
+        item.code = E->CHECKVAL<bool>(6, false);
+        item.popup = E->CHECKVAL<std::string>(7, "");
+        item.money = E->CHECKVAL<uint32>(8, 0);
+
+        if (!lua_isnoneornil(E->L, 9))
+        {
+            luaL_checktype(E->L, 9, LUA_TTABLE);
+            ReadCondition(E, 9, item.condition);
+        }
+        item.conditional = !item.condition.IsEmpty();
+
+        menu->items.push_back(std::move(item));
+        E->Push(uint32(menu->items.size()));
+        return 1;
+    }
+
+    /**
+     * Removes all items from the [ElunaGossipMenu].
+     */
+    int ClearItems(Eluna* /*E*/, ElunaGossipMenu* menu)
+    {
+        menu->items.clear();
+        return 0;
+    }
+
+    /**
+     * Returns the amount of items in the [ElunaGossipMenu].
+     *
+     * @return uint32 count
+     */
+    int GetItemCount(Eluna* E, ElunaGossipMenu* menu)
+    {
+        E->Push(uint32(menu->items.size()));
+        return 1;
+    }
+
+    /**
+     * Returns the entry ID of the header text of the [ElunaGossipMenu].
+     *
+     * @return uint32 npcText
+     */
+    int GetText(Eluna* E, ElunaGossipMenu* menu)
+    {
+        E->Push(menu->npcText);
+        return 1;
+    }
+
+    /**
+     * Sets the entry ID of the header text of the [ElunaGossipMenu].
+     *
+     * @param uint32 npcText : entry ID of a header text in npc_text database table
+     */
+    int SetText(Eluna* E, ElunaGossipMenu* menu)
+    {
+        menu->npcText = E->CHECKVAL<uint32>(2);
+        return 0;
+    }
+
+    /**
+     * Returns the menu ID of the [ElunaGossipMenu].
+     *
+     * @return uint32 menuId
+     */
+    int GetMenuId(Eluna* E, ElunaGossipMenu* menu)
+    {
+        E->Push(menu->menuId);
+        return 1;
+    }
+
+    /**
+     * Sets the menu ID of the [ElunaGossipMenu]. The menu ID is only used when the sender is a [Player], see [Player:GossipSendMenu].
+     *
+     * @param uint32 menuId
+     */
+    int SetMenuId(Eluna* E, ElunaGossipMenu* menu)
+    {
+        menu->menuId = E->CHECKVAL<uint32>(2);
+        return 0;
+    }
+
+    /**
+     * Sends the [ElunaGossipMenu] to the [Player].
+     *
+     * Replaces any gossip items the player currently has, so calling [Player:GossipClearMenu] first is not needed.
+     * Items with conditions the player does not meet are left out.
+     *
+     * @param [Player] player : the player to send the menu to
+     * @param [Object] sender : object acting as the source of the sent gossip menu
+     */
+    int Send(Eluna* E, ElunaGossipMenu* menu)
+    {
+        Player* player = E->CHECKOBJ<Player>(2);
+        Object* sender = E->CHECKOBJ<Object>(3);
+
+        player->PlayerTalkClass->ClearMenus();
+
+        GossipMenu& gossipMenu = player->PlayerTalkClass->GetGossipMenu();
+        for (ElunaGossipMenuItem const& item : menu->items)
+        {
+            if (item.conditional && !IsConditionMet(player, item.condition))
+                continue;
+
+            gossipMenu.AddMenuItem(-1, GossipOptionIcon(item.icon), item.text, item.sender, item.intid, item.popup, item.money, item.code);
+        }
+
+        if (sender->GetTypeId() == TYPEID_PLAYER)
+            gossipMenu.SetMenuId(menu->menuId);
+
+        player->PlayerTalkClass->SendGossipMenu(menu->npcText, sender->GET_GUID());
+        return 0;
+    }
+
+    ElunaRegister<ElunaGossipMenu> GossipMenuMethods[] =
+    {
+        // Getters
+        { "GetItemCount", &LuaGossipMenu::GetItemCount },
+        { "GetText", &LuaGossipMenu::GetText },
+        { "GetMenuId", &LuaGossipMenu::GetMenuId },
+
+        // Setters
+        { "SetText", &LuaGossipMenu::SetText },
+        { "SetMenuId", &LuaGossipMenu::SetMenuId },
+
+        // Other
+        { "AddItem", &LuaGossipMenu::AddItem },
+        { "ClearItems", &LuaGossipMenu::ClearItems },
+        { "Send", &LuaGossipMenu::Send }
+    };
+};
+
+#endif
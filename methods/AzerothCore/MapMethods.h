@@ -8,6 +8,7 @@
 #define MAPMETHODS_H
 
 #include "ElunaInstanceAI.h"
+#include "ElunaObjectVariables.h"
 #include "LuaValue.h"
 
 /***
@@ -351,9 +352,48 @@ namespace LuaMap
     //     return LuaVal::PushLuaVal(E->L, map->lua_data);
     // }
     
+    /**
+     * Returns a variable set with [Map:SetData], or a table of all variables of the [Map] if no field is given.
+     *
+     * Variables can hold any Lua value and are kept by the Lua state until the [Map] is created again
+     *   or destroyed. A reload of the Lua state clears them.
+     *
+     * Changes made to the returned table are kept.
+     *
+     * @param string field = nil : name of the variable
+     * @return any value : value of the variable, or a table of all variables if no field is given
+     */
+    int GetData(Eluna* E, Map* map)
+    {
+        ElunaObjectVariables::Key key = { map->GetId(), map->GetInstanceId(), 0 };
+        if (lua_isnoneornil(E->L, 2))
+            E->objectVariables->PushTable(key);
+        else
+            E->objectVariables->Push(key, 2);
+        return 1;
+    }
+
+    /**
+     * Sets a variable of the [Map], see [Map:GetData].
+     *
+     * @param string field : name of the variable
+     * @param any value : new value of the variable, nil removes it
+     */
+    int SetData(Eluna* E, Map* map)
+    {
+        if (lua_isnoneornil(E->L, 2))
+            return luaL_argerror(E->L, 2, "field expected");
+
+        ElunaObjectVariables::Key key = { map->GetId(), map->GetInstanceId(), 0 };
+        lua_settop(E->L, 3);
+        E->objectVariables->Set(key, 2, 3);
+        return 0;
+    }
+
     ElunaRegister<Map> MapMethods[] =
     {
         // Getters
+        { "GetData", &LuaMap::GetData },
         { "GetName", &LuaMap::GetName },
         { "GetDifficulty", &LuaMap::GetDifficulty },
         { "GetInstanceId", &LuaMap::GetInstanceId },
@@ -366,6 +406,7 @@ namespace LuaMap
         { "GetWorldObject", &LuaMap::GetWorldObject },
 
         // Setters
+        { "SetData", &LuaMap::SetData },
         { "SetWeather", &LuaMap::SetWeather },
 
         // Boolean
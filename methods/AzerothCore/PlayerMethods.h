@@ -1207,6 +1207,68 @@ namespace LuaPlayer
         return 1;
     }
 
+    /**
+     * Returns all quests in the quest log of the [Player] in one table, read in a single pass over the quest log.
+     *
+     * Each quest is described by a table with the fields below.
+     *
+     * @table
+     * @columns [Field, Type, Comment]
+     * @values [entry, uint32, "Entry of the quest"]
+     * @values [slot, uint32, "Quest log slot of the quest"]
+     * @values [status, [QuestStatus], "Status of the quest, see [Player:GetQuestStatus]"]
+     * @values [objectives, table, "Current creature, gameobject or spell cast counts of the quest objectives"]
+     * @values [items, table, "Current item counts of the quest item objectives"]
+     *
+     *     for _, quest in ipairs(player:GetQuestLogSnapshot()) do
+     *         print(quest.entry, quest.status, quest.objectives[1])
+     *     end
+     *
+     * @return table quests : table of quest tables, refer to the table above
+     */
+    int GetQuestLogSnapshot(Eluna* E, Player* player)
+    {
+        int index = 0;
+        lua_createtable(E->L, MAX_QUEST_LOG_SIZE, 0);
+        for (uint8 slot = 0; slot < MAX_QUEST_LOG_SIZE; ++slot)
+        {
+            uint32 questId = player->GetQuestSlotQuestId(slot);
+            if (!questId)
+                continue;
+
+            Quest const* quest = eObjectMgr->GetQuestTemplate(questId);
+            if (!quest)
+                continue;
+
+            lua_createtable(E->L, 0, 5);
+            E->Push(questId);
+            lua_setfield(E->L, -2, "entry");
+            E->Push(uint32(slot));
+            lua_setfield(E->L, -2, "slot");
+            E->Push(player->GetQuestStatus(questId));
+            lua_setfield(E->L, -2, "status");
+
+            lua_createtable(E->L, QUEST_OBJECTIVES_COUNT, 0);
+            for (uint8 i = 0; i < QUEST_OBJECTIVES_COUNT; ++i)
+            {
+                E->Push(uint32(player->GetQuestSlotCounter(slot, i)));
+                lua_rawseti(E->L, -2, i + 1);
+            }
+            lua_setfield(E->L, -2, "objectives");
+
+            lua_createtable(E->L, QUEST_ITEM_OBJECTIVES_COUNT, 0);
+            for (uint8 i = 0; i < QUEST_ITEM_OBJECTIVES_COUNT; ++i)
+            {
+                E->Push(quest->RequiredItemId[i] ? std::min(player->GetItemCount(quest->RequiredItemId[i], true), quest->RequiredItemCount[i]) : 0);
+                lua_rawseti(E->L, -2, i + 1);
+            }
+            lua_setfield(E->L, -2, "items");
+
+            lua_rawseti(E->L, -2, ++index);
+        }
+        return 1;
+    }
+
     /**
      * Returns 'true' if the [Player]s [Quest] specified by entry ID has been rewarded, 'false' otherwise.
      *
@@ -1324,6 +1386,83 @@ namespace LuaPlayer
         return 1;
     }
 
+    static void PushInventoryItem(Eluna* E, Item* item, int& index)
+    {
+        lua_createtable(E->L, 0, 6);
+        E->Push(item->GetEntry());
+        lua_setfield(E->L, -2, "entry");
+        E->Push(item->GetCount());
+        lua_setfield(E->L, -2, "count");
+        E->Push(item->GetGUID().GetCounter());
+        lua_setfield(E->L, -2, "guid");
+        E->Push(uint32(item->GetBagSlot()));
+        lua_setfield(E->L, -2, "bag");
+        E->Push(uint32(item->GetSlot()));
+        lua_setfield(E->L, -2, "slot");
+
+        lua_createtable(E->L, MAX_INSPECTED_ENCHANTMENT_SLOT, 0);
+        for (uint32 i = 0; i < MAX_INSPECTED_ENCHANTMENT_SLOT; ++i)
+        {
+            E->Push(item->GetEnchantmentId(EnchantmentSlot(i)));
+            lua_rawseti(E->L, -2, i + 1);
+        }
+        lua_setfield(E->L, -2, "enchants");
+
+        lua_rawseti(E->L, -2, ++index);
+    }
+
+    static void PushInventoryRange(Eluna* E, Player* player, uint8 slotStart, uint8 slotEnd, uint8 bagStart, uint8 bagEnd, int& index)
+    {
+        for (uint8 slot = slotStart; slot < slotEnd; ++slot)
+            if (Item* item = player->GetItemByPos(INVENTORY_SLOT_BAG_0, slot))
+                PushInventoryItem(E, item, index);
+
+        for (uint8 i = bagStart; i < bagEnd; ++i)
+            if (Bag* bag = player->GetBagByPos(i))
+                for (uint32 slot = 0; slot < bag->GetBagSize(); ++slot)
+                    if (Item* item = bag->GetItemByPos(uint8(slot)))
+                        PushInventoryItem(E, item, index);
+    }
+
+    /**
+     * Returns all items of the [Player] in one table, read in a single pass over the equipment, the backpack, the equipped bags,
+     *   the keyring and the currency token slots.
+     *
+     * Each item is described by a table with the fields below. The bag and slot are the same as used by [Player:GetItemByPos].
+     * Equipped bags are included as items themselves, followed by their contents. Sold items waiting in the buyback slots are not included.
+     *
+     * @table
+     * @columns [Field, Type, Comment]
+     * @values [entry, uint32, "Entry of the item"]
+     * @values [count, uint32, "Stack count of the item"]
+     * @values [guid, uint32, "Low GUID of the item"]
+     * @values [bag, uint8, "Bag the item is in"]
+     * @values [slot, uint8, "Slot the item is in within the bag"]
+     * @values [enchants, table, "Enchantment IDs of the item indexed by [EnchantmentSlot] + 1, 0 for empty slots"]
+     *
+     *     for _, item in ipairs(player:GetInventorySnapshot(true)) do
+     *         if item.entry == 49426 then
+     *             total = total + item.count
+     *         end
+     *     end
+     *
+     * @param bool includeBank = false : if true, items in the bank and bank bags are included
+     * @return table items : table of item tables, refer to the table above
+     */
+    int GetInventorySnapshot(Eluna* E, Player* player)
+    {
+        bool includeBank = E->CHECKVAL<bool>(2, false);
+
+        int index = 0;
+        lua_newtable(E->L);
+        PushInventoryRange(E, player, EQUIPMENT_SLOT_START, INVENTORY_SLOT_ITEM_END, INVENTORY_SLOT_BAG_START, INVENTORY_SLOT_BAG_END, index);
+        PushInventoryRange(E, player, KEYRING_SLOT_START, KEYRING_SLOT_END, 0, 0, index);
+        PushInventoryRange(E, player, CURRENCYTOKEN_SLOT_START, CURRENCYTOKEN_SLOT_END, 0, 0, index);
+        if (includeBank)
+            PushInventoryRange(E, player, BANK_SLOT_ITEM_START, BANK_SLOT_BAG_END, BANK_SLOT_BAG_START, BANK_SLOT_BAG_END, index);
+        return 1;
+    }
+
     /**
      * Returns an [Item] from the player by guid.
      *
@@ -3919,6 +4058,7 @@ namespace LuaPlayer
         { "GetLevelPlayedTime", &LuaPlayer::GetLevelPlayedTime },
         { "GetTotalPlayedTime", &LuaPlayer::GetTotalPlayedTime },
         { "GetItemByPos", &LuaPlayer::GetItemByPos },
+        { "GetInventorySnapshot", &LuaPlayer::GetInventorySnapshot },
         { "GetItemByEntry", &LuaPlayer::GetItemByEntry },
         { "GetItemByGUID", &LuaPlayer::GetItemByGUID },
         { "GetMailItem", &LuaPlayer::GetMailItem },
@@ -3930,6 +4070,7 @@ namespace LuaPlayer
         { "GetPhaseMaskForSpawn", &LuaPlayer::GetPhaseMaskForSpawn },
         { "GetReqKillOrCastCurrentCount", &LuaPlayer::GetReqKillOrCastCurrentCount },
         { "GetQuestStatus", &LuaPlayer::GetQuestStatus },
+        { "GetQuestLogSnapshot", &LuaPlayer::GetQuestLogSnapshot },
         { "GetInGameTime", &LuaPlayer::GetInGameTime },
         { "GetComboPoints", &LuaPlayer::GetComboPoints },
         { "GetComboTarget", &LuaPlayer::GetComboTarget },
@@ -0,0 +1,196 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef SPAWNGROUPMETHODS_H
+#define SPAWNGROUPMETHODS_H
+
+/***
+ * A group of [Creature]s and [GameObject]s spawned together with [WorldObject:SpawnCreatures] or [WorldObject:SpawnGameObjects].
+ *
+ * The group only stores the GUIDs and formation positions of its members, members that have despawned are skipped.
+ * A group can only be used in the state of the map it was spawned on.
+ *
+ * Inherits all methods from: none
+ */
+namespace LuaSpawnGroup
+{
+    static Map* GetGroupMap(Eluna* E, ElunaSpawnGroup* group)
+    {
+        Map* map = eMapMgr->FindMap(group->mapId, group->instanceId);
+        if (map && E->GetBoundMap() && E->GetBoundMap() != map)
+            return nullptr;
+        return map;
+    }
+
+    /**
+     * Returns the amount of members in the [ElunaSpawnGroup], including members that have despawned since.
+     *
+     * @return uint32 count
+     */
+    int GetCount(Eluna* E, ElunaSpawnGroup* group)
+    {
+        E->Push(uint32(group->creatures.size() + group->gameObjects.size()));
+        return 1;
+    }
+
+    /**
+     * Returns the amount of [Creature]s in the [ElunaSpawnGroup] that are still spawned and alive.
+     *
+     * @return uint32 count
+     */
+    int GetAliveCount(Eluna* E, ElunaSpawnGroup* group)
+    {
+        uint32 count = 0;
+        if (Map* map = GetGroupMap(E, group))
+        {
+            for (ElunaSpawnGroupMember const& member : group->creatures)
+                if (Creature* creature = map->GetCreature(member.guid))
+                    if (creature->IsAlive())
+                        ++count;
+        }
+
+        E->Push(count);
+        return 1;
+    }
+
+    /**
+     * Returns a table of the [Creature]s in the [ElunaSpawnGroup] that are still spawned.
+     *
+     * @return table creatures
+     */
+    int GetCreatures(Eluna* E, ElunaSpawnGroup* group)
+    {
+        lua_createtable(E->L, int(group->creatures.size()), 0);
+        if (Map* map = GetGroupMap(E, group))
+        {
+            int i = 0;
+            for (ElunaSpawnGroupMember const& member : group->creatures)
+            {
+                if (Creature* creature = map->GetCreature(member.guid))
+                {
+                    E->Push(creature);
+                    lua_rawseti(E->L, -2, ++i);
+                }
+            }
+        }
+        return 1;
+    }
+
+    /**
+     * Returns a table of the [GameObject]s in the [ElunaSpawnGroup] that are still spawned.
+     *
+     * @return table gameObjects
+     */
+    int GetGameObjects(Eluna* E, ElunaSpawnGroup* group)
+    {
+        lua_createtable(E->L, int(group->gameObjects.size()), 0);
+        if (Map* map = GetGroupMap(E, group))
+        {
+            int i = 0;
+            for (ElunaSpawnGroupMember const& member : group->gameObjects)
+            {
+                if (GameObject* object = map->GetGameObject(member.guid))
+                {
+                    E->Push(object);
+                    lua_rawseti(E->L, -2, ++i);
+                }
+            }
+        }
+        return 1;
+    }
+
+    /**
+     * Returns a table of the GUIDs of all members of the [ElunaSpawnGroup], [Creature]s first.
+     *
+     * @return table guids
+     */
+    int GetGUIDs(Eluna* E, ElunaSpawnGroup* group)
+    {
+        lua_createtable(E->L, int(group->creatures.size() + group->gameObjects.size()), 0);
+        int i = 0;
+        for (ElunaSpawnGroupMember const& member : group->creatures)
+        {
+            E->Push(member.guid);
+            lua_rawseti(E->L, -2, ++i);
+        }
+        for (ElunaSpawnGroupMember const& member : group->gameObjects)
+        {
+            E->Push(member.guid);
+            lua_rawseti(E->L, -2, ++i);
+        }
+        return 1;
+    }
+
+    /**
+     * Respawns the dead [Creature]s of the [ElunaSpawnGroup] at their formation positions.
+     *
+     * Reusing the same creatures for each wave avoids creating and destroying them every time.
+     * Only creatures that have not despawned can be respawned, spawn the group with [TempSummonType] MANUAL_DESPAWN to keep dead creatures.
+     *
+     * @return uint32 count : amount of respawned creatures
+     */
+    int Respawn(Eluna* E, ElunaSpawnGroup* group)
+    {
+        uint32 count = 0;
+        if (Map* map = GetGroupMap(E, group))
+        {
+            for (ElunaSpawnGroupMember const& member : group->creatures)
+            {
+                Creature* creature = map->GetCreature(member.guid);
+                if (!creature || creature->IsAlive())
+                    continue;
+
+                creature->Respawn();
+                creature->NearTeleportTo(member.x, member.y, member.z, member.o);
+                ++count;
+            }
+        }
+
+        E->Push(count);
+        return 1;
+    }
+
+    /**
+     * Despawns all members of the [ElunaSpawnGroup] and empties it.
+     *
+     * @param uint32 delay = 0 : [Creature] despawn delay in milliseconds
+     */
+    int Despawn(Eluna* E, ElunaSpawnGroup* group)
+    {
+        uint32 msTimeToDespawn = E->CHECKVAL<uint32>(2, 0);
+
+        if (Map* map = GetGroupMap(E, group))
+        {
+            for (ElunaSpawnGroupMember const& member : group->creatures)
+                if (Creature* creature = map->GetCreature(member.guid))
+                    creature->ForcedDespawn(msTimeToDespawn);
+
+            for (ElunaSpawnGroupMember const& member : group->gameObjects)
+                if (GameObject* object = map->GetGameObject(member.guid))
+                    object->SetLootState(GO_JUST_DEACTIVATED);
+        }
+
+        group->creatures.clear();
+        group->gameObjects.clear();
+        return 0;
+    }
+
+    ElunaRegister<ElunaSpawnGroup> SpawnGroupMethods[] =
+    {
+        // Getters
+        { "GetCount", &LuaSpawnGroup::GetCount },
+        { "GetAliveCount", &LuaSpawnGroup::GetAliveCount },
+        { "GetCreatures", &LuaSpawnGroup::GetCreatures },
+        { "GetGameObjects", &LuaSpawnGroup::GetGameObjects },
+        { "GetGUIDs", &LuaSpawnGroup::GetGUIDs },
+
+        // Other
+        { "Respawn", &LuaSpawnGroup::Respawn },
+        { "Despawn", &LuaSpawnGroup::Despawn }
+    };
+};
+
+#endif
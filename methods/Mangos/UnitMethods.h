@@ -2155,24 +2155,10 @@ namespace LuaUnit
         return 0;
     }
 
-    /**
-     * Adds the [Aura] of the given spell entry on the given target from the [Unit].
-     *
-     * @param uint32 spell : entry of a spell
-     * @param [Unit] target : aura will be applied on the target
-     * @return [Aura] aura
-     */
-    int AddAura(Eluna* E, Unit* unit)
+    static bool AddAuraTo(Unit* unit, Unit* target, SpellEntry const* spellEntry)
     {
-        uint32 spell = E->CHECKVAL<uint32>(2);
-        Unit* target = E->CHECKOBJ<Unit>(3);
-
-        SpellEntry const* spellEntry = sSpellStore.LookupEntry(spell);
-        if (!spellEntry)
-            return 1;
-
         if (!IsSpellAppliesAura(spellEntry) && !IsSpellHaveEffect(spellEntry, SPELL_EFFECT_PERSISTENT_AREA_AURA))
-            return 1;
+            return false;
 
         SpellAuraHolder* holder = CreateSpellAuraHolder(spellEntry, target, unit);
 
@@ -2195,8 +2181,26 @@ namespace LuaUnit
                 holder->AddAura(aur, SpellEffIndex(i));
             }
         }
+        return target->AddSpellAuraHolder(holder);
+    }
 
-        E->Push(target->AddSpellAuraHolder(holder));
+    /**
+     * Adds the [Aura] of the given spell entry on the given target from the [Unit].
+     *
+     * @param uint32 spell : entry of a spell
+     * @param [Unit] target : aura will be applied on the target
+     * @return [Aura] aura
+     */
+    int AddAura(Eluna* E, Unit* unit)
+    {
+        uint32 spell = E->CHECKVAL<uint32>(2);
+        Unit* target = E->CHECKOBJ<Unit>(3);
+
+        SpellEntry const* spellEntry = sSpellStore.LookupEntry(spell);
+        if (!spellEntry)
+            return 1;
+
+        E->Push(AddAuraTo(unit, target, spellEntry));
         return 1;
     }
 
@@ -2279,6 +2283,44 @@ namespace LuaUnit
         return 0;
     }
 
+    static void DealDamageTo(Unit* unit, Unit* target, uint32 damage, bool durabilityloss, uint32 school, uint32 spell)
+    {
+        // flat melee damage without resistence/etc reduction
+        if (school == MAX_SPELL_SCHOOL)
+        {
+            unit->DealDamage(target, damage, NULL, DIRECT_DAMAGE, SPELL_SCHOOL_MASK_NORMAL, NULL, durabilityloss);
+            unit->SendAttackStateUpdate(HITINFO_NORMALSWING2, target, SPELL_SCHOOL_MASK_NORMAL, damage, 0, 0, VICTIMSTATE_NORMAL, 0);
+            return;
+        }
+
+        SpellSchoolMask schoolmask = SpellSchoolMask(1 << school);
+
+        if (schoolmask & SPELL_SCHOOL_MASK_NORMAL)
+            damage = unit->CalcArmorReducedDamage(target, damage);
+
+        // melee damage by specific school
+        if (!spell)
+        {
+            uint32 absorb = 0;
+            uint32 resist = 0;
+
+            target->CalculateDamageAbsorbAndResist(unit, schoolmask, SPELL_DIRECT_DAMAGE, damage, &absorb, &resist);
+
+            if (damage <= absorb + resist)
+                damage = 0;
+            else
+                damage -= absorb + resist;
+
+            unit->DealDamageMods(target, damage, &absorb);
+            unit->DealDamage(target, damage, NULL, DIRECT_DAMAGE, schoolmask, NULL, false);
+            unit->SendAttackStateUpdate(HITINFO_NORMALSWING2, target, schoolmask, damage, absorb, resist, VICTIMSTATE_NORMAL, 0);
+            return;
+        }
+
+        // non-melee damage
+        unit->SpellNonMeleeDamageLog(target, spell, damage);
+    }
+
     /**
      * Makes the [Unit] damage the target [Unit]
      *
@@ -2312,63 +2354,197 @@ namespace LuaUnit
         if (school > MAX_SPELL_SCHOOL)
             return luaL_argerror(E->L, 6, "valid SpellSchool expected");
 
-        // flat melee damage without resistence/etc reduction
-        if (school == MAX_SPELL_SCHOOL)
+        DealDamageTo(unit, target, damage, durabilityloss, school, spell);
+        return 0;
+    }
+
+    /**
+     * Makes the [Unit] heal the target [Unit] with given spell
+     *
+     * @param [Unit] target : [Unit] to heal
+     * @param uint32 spell : spell that causes the healing
+     * @param uint32 amount : amount to heal
+     * @param bool critical = false : if true, heal is logged as critical
+     */
+    int DealHeal(Eluna* E, Unit* unit)
+    {
+        Unit* target = E->CHECKOBJ<Unit>(2);
+        uint32 spell = E->CHECKVAL<uint32>(3);
+        uint32 amount = E->CHECKVAL<uint32>(4);
+        bool critical = E->CHECKVAL<bool>(5, false);
+
+        SpellEntry const* spellEntry = sSpellStore.LookupEntry(spell);
+        if (spellEntry)
+            unit->DealHeal(target, amount, spellEntry, critical);
+
+        return 0;
+    }
+
+    static void ReadTargets(Eluna* E, int index, std::vector<Unit*>& targets)
+    {
+        luaL_checktype(E->L, index, LUA_TTABLE);
+
+        int count = lua_rawlen(E->L, index);
+        targets.reserve(count);
+        for (int i = 1; i <= count; ++i)
         {
-            unit->DealDamage(target, damage, NULL, DIRECT_DAMAGE, SPELL_SCHOOL_MASK_NORMAL, NULL, durabilityloss);
-            unit->SendAttackStateUpdate(HITINFO_NORMALSWING2, target, SPELL_SCHOOL_MASK_NORMAL, damage, 0, 0, VICTIMSTATE_NORMAL, 0);
-            return 0;
+            lua_rawgeti(E->L, index, i);
+            Unit* target = E->CHECKOBJ<Unit>(lua_gettop(E->L), false);
+            targets.push_back(target && target->IsInWorld() ? target : nullptr);
+            lua_pop(E->L, 1);
         }
+    }
 
-        SpellSchoolMask schoolmask = SpellSchoolMask(1 << school);
+    /**
+     * Makes the [Unit] cast the spell on each of the targets.
+     *
+     * Works like [Unit:CastSpell] called for each target, but the arguments and the spell are only checked once.
+     * Targets that no longer exist or are not in the world are skipped.
+     *
+     *     local targets = creature:GetPlayersInRange(100)
+     *     creature:CastSpellOnTargets(targets, 40163, true)
+     *
+     * @param table targets : table of [Unit]s
+     * @param uint32 spell : entry of a spell
+     * @param bool triggered = false : if true the spell is instant and has no cost
+     * @return table results : `true` for each target the spell was cast on, `false` for skipped targets, in the same order as the targets
+     */
+    int CastSpellOnTargets(Eluna* E, Unit* unit)
+    {
+        uint32 spell = E->CHECKVAL<uint32>(3);
+        bool triggered = E->CHECKVAL<bool>(4, false);
 
-        if (schoolmask & SPELL_SCHOOL_MASK_NORMAL)
-            damage = unit->CalcArmorReducedDamage(target, damage);
+        std::vector<Unit*> targets;
+        ReadTargets(E, 2, targets);
 
-        // melee damage by specific school
-        if (!spell)
+        SpellEntry const* spellEntry = sSpellStore.LookupEntry(spell);
+
+        lua_createtable(E->L, int(targets.size()), 0);
+        for (size_t i = 0; i < targets.size(); ++i)
         {
-            uint32 absorb = 0;
-            uint32 resist = 0;
+            Unit* target = targets[i];
+            if (spellEntry && target)
+                unit->CastSpell(target, spell, triggered);
 
-            target->CalculateDamageAbsorbAndResist(unit, schoolmask, SPELL_DIRECT_DAMAGE, damage, &absorb, &resist);
+            E->Push(spellEntry && target);
+            lua_rawseti(E->L, -2, int(i + 1));
+        }
+        return 1;
+    }
 
-            if (damage <= absorb + resist)
-                damage = 0;
+    /**
+     * Adds the [Aura] of the given spell entry on each of the targets from the [Unit].
+     *
+     * Works like [Unit:AddAura] called for each target, but the arguments and the spell are only checked once.
+     * Targets that no longer exist or are not in the world are skipped.
+     *
+     * @param uint32 spell : entry of a spell
+     * @param table targets : table of [Unit]s
+     * @return table results : `true` for each target the aura was applied to, `false` for the others, in the same order as the targets
+     */
+    int AddAuraToTargets(Eluna* E, Unit* unit)
+    {
+        uint32 spell = E->CHECKVAL<uint32>(2);
+
+        std::vector<Unit*> targets;
+        ReadTargets(E, 3, targets);
+
+        SpellEntry const* spellEntry = sSpellStore.LookupEntry(spell);
+
+        lua_createtable(E->L, int(targets.size()), 0);
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+            Unit* target = targets[i];
+            if (spellEntry && target)
+                E->Push(AddAuraTo(unit, target, spellEntry));
             else
-                damage -= absorb + resist;
+                E->Push(false);
 
-            unit->DealDamageMods(target, damage, &absorb);
-            unit->DealDamage(target, damage, NULL, DIRECT_DAMAGE, schoolmask, NULL, false);
-            unit->SendAttackStateUpdate(HITINFO_NORMALSWING2, target, schoolmask, damage, absorb, resist, VICTIMSTATE_NORMAL, 0);
-            return 0;
+            lua_rawseti(E->L, -2, int(i + 1));
         }
+        return 1;
+    }
 
-        // non-melee damage
-        unit->SpellNonMeleeDamageLog(target, spell, damage);
-        return 0;
+    /**
+     * Makes the [Unit] damage each of the targets.
+     *
+     * Works like [Unit:DealDamage] called for each target, but the arguments are only checked once.
+     * Targets that no longer exist or are not in the world are skipped.
+     *
+     * @param table targets : table of [Unit]s
+     * @param uint32 damage : amount to damage
+     * @param bool durabilityloss = true : if false, the damage does not do durability damage
+     * @param [SpellSchools] school = MAX_SPELL_SCHOOL : school the damage is done in or MAX_SPELL_SCHOOL for direct damage, see [Unit:DealDamage]
+     * @param uint32 spell = 0 : spell that inflicts the damage
+     * @return table results : health of each target after the damage, `false` for skipped targets, in the same order as the targets
+     */
+    int DealDamageToTargets(Eluna* E, Unit* unit)
+    {
+        uint32 damage = E->CHECKVAL<uint32>(3);
+        bool durabilityloss = E->CHECKVAL<bool>(4, true);
+        uint32 school = E->CHECKVAL<uint32>(5, MAX_SPELL_SCHOOL);
+        uint32 spell = E->CHECKVAL<uint32>(6, 0);
+        if (school > MAX_SPELL_SCHOOL)
+            return luaL_argerror(E->L, 5, "valid SpellSchool expected");
+
+        std::vector<Unit*> targets;
+        ReadTargets(E, 2, targets);
+
+        lua_createtable(E->L, int(targets.size()), 0);
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+            Unit* target = targets[i];
+            if (target)
+            {
+                DealDamageTo(unit, target, damage, durabilityloss, school, spell);
+                E->Push(target->GetHealth());
+            }
+            else
+                E->Push(false);
+
+            lua_rawseti(E->L, -2, int(i + 1));
+        }
+        return 1;
     }
 
     /**
-     * Makes the [Unit] heal the target [Unit] with given spell
+     * Makes the [Unit] heal each of the targets with given spell.
      *
-     * @param [Unit] target : [Unit] to heal
+     * Works like [Unit:DealHeal] called for each target, but the arguments and the spell are only checked once.
+     * Targets that no longer exist or are not in the world are skipped.
+     *
+     * @param table targets : table of [Unit]s
      * @param uint32 spell : spell that causes the healing
      * @param uint32 amount : amount to heal
      * @param bool critical = false : if true, heal is logged as critical
+     * @return table results : health of each target after the heal, `false` for skipped targets, in the same order as the targets
      */
-    int DealHeal(Eluna* E, Unit* unit)
+    int DealHealToTargets(Eluna* E, Unit* unit)
     {
-        Unit* target = E->CHECKOBJ<Unit>(2);
         uint32 spell = E->CHECKVAL<uint32>(3);
         uint32 amount = E->CHECKVAL<uint32>(4);
         bool critical = E->CHECKVAL<bool>(5, false);
 
+        std::vector<Unit*> targets;
+        ReadTargets(E, 2, targets);
+
         SpellEntry const* spellEntry = sSpellStore.LookupEntry(spell);
-        if (spellEntry)
-            unit->DealHeal(target, amount, spellEntry, critical);
 
-        return 0;
+        lua_createtable(E->L, int(targets.size()), 0);
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+            Unit* target = targets[i];
+            if (spellEntry && target)
+            {
+                unit->DealHeal(target, amount, spellEntry, critical);
+                E->Push(target->GetHealth());
+            }
+            else
+                E->Push(false);
+
+            lua_rawseti(E->L, -2, int(i + 1));
+        }
+        return 1;
     }
 
     /**
@@ -2661,6 +2837,10 @@ namespace LuaUnit
         { "MoveClear", &LuaUnit::MoveClear },
         { "DealDamage", &LuaUnit::DealDamage },
         { "DealHeal", &LuaUnit::DealHeal },
+        { "CastSpellOnTargets", &LuaUnit::CastSpellOnTargets },
+        { "AddAuraToTargets", &LuaUnit::AddAuraToTargets },
+        { "DealDamageToTargets", &LuaUnit::DealDamageToTargets },
+        { "DealHealToTargets", &LuaUnit::DealHealToTargets },
         { "AddThreat", &LuaUnit::AddThreat },
 #if !defined(CLASSIC)
         { "RemoveArenaAuras", &LuaUnit::RemoveArenaAuras },
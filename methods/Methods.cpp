@@ -13,6 +13,9 @@
 
 // Method includes
 #include "GlobalMethods.h"
+#include "GossipMenuMethods.h"
+#include "SpawnGroupMethods.h"
+#include "AuctionSnapshotMethods.h"
 #include "ObjectMethods.h"
 #include "WorldObjectMethods.h"
 #include "UnitMethods.h"
@@ -120,6 +123,16 @@ void RegisterMethods(Eluna* E)
     ElunaTemplate<ElunaQuery>::Register(E, "ElunaQuery");
     ElunaTemplate<ElunaQuery>::SetMethods(E, LuaQuery::QueryMethods);
 
+    ElunaTemplate<ElunaGossipMenu>::Register(E, "ElunaGossipMenu");
+    ElunaTemplate<ElunaGossipMenu>::SetMethods(E, LuaGossipMenu::GossipMenuMethods);
+
+    ElunaTemplate<ElunaSpawnGroup>::Register(E, "ElunaSpawnGroup");
+    ElunaTemplate<ElunaSpawnGroup>::SetMethods(E, LuaSpawnGroup::SpawnGroupMethods);
+
+    ElunaTemplate<ElunaAuctionSnapshot>::Register(E, "ElunaAuctionSnapshot");
+    ElunaTemplate<ElunaAuctionSnapshot>::SetMethods(E, LuaAuctionSnapshot::AuctionSnapshotMethods);
+
+#if !defined ELUNA_NATIVE_INT64
     ElunaTemplate<long long>::Register(E, "long long");
     ElunaTemplate<long long>::SetMethods(E, LuaBigInt::LongLongMethods);
 
@@ -128,6 +141,7 @@ void RegisterMethods(Eluna* E)
 
     ElunaTemplate<ObjectGuid>::Register(E, "ObjectGuid");
     ElunaTemplate<ObjectGuid>::SetMethods(E, LuaBigInt::ObjectGuidMethods);
+#endif
 
     LuaCustom::RegisterCustomMethods(E);
 
@@ -0,0 +1,220 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef AUCTIONSNAPSHOTMETHODS_H
+#define AUCTIONSNAPSHOTMETHODS_H
+
+/***
+ * A read-only copy of the auction houses, indexed by item entry.
+ *
+ * The snapshot does not change when auctions are added, bought or expire, take a new snapshot to see the changes.
+ * Prices are buyout prices of a single item, auctions without a buyout have no price.
+ *
+ * Created with [Global:GetAuctionSnapshot].
+ *
+ * Inherits all methods from: none
+ */
+namespace LuaAuctionSnapshot
+{
+    static void PushAuction(Eluna* E, ElunaAuction const& auction)
+    {
+        lua_createtable(E->L, 0, 11);
+        E->Push(auction.id);
+        lua_setfield(E->L, -2, "id");
+        E->Push(auction.house);
+        lua_setfield(E->L, -2, "house");
+        E->Push(auction.entry);
+        lua_setfield(E->L, -2, "entry");
+        E->Push(auction.count);
+        lua_setfield(E->L, -2, "count");
+        E->Push(auction.seller);
+        lua_setfield(E->L, -2, "seller");
+        E->Push(auction.bidder);
+        lua_setfield(E->L, -2, "bidder");
+        E->Push(auction.startBid);
+        lua_setfield(E->L, -2, "startBid");
+        E->Push(auction.bid);
+        lua_setfield(E->L, -2, "bid");
+        E->Push(auction.buyout);
+        lua_setfield(E->L, -2, "buyout");
+        E->Push(auction.GetUnitPrice());
+        lua_setfield(E->L, -2, "price");
+        E->Push(auction.expireTime);
+        lua_setfield(E->L, -2, "expireTime");
+    }
+
+    static void PushStats(Eluna* E, ElunaAuctionStats const& stats)
+    {
+        lua_createtable(E->L, 0, 5);
+        E->Push(stats.auctions);
+        lua_setfield(E->L, -2, "auctions");
+        E->Push(stats.items);
+        lua_setfield(E->L, -2, "items");
+        E->Push(stats.minPrice);
+        lua_setfield(E->L, -2, "minPrice");
+        E->Push(stats.medianPrice);
+        lua_setfield(E->L, -2, "medianPrice");
+        E->Push(stats.maxPrice);
+        lua_setfield(E->L, -2, "maxPrice");
+    }
+
+    /**
+     * Returns the amount of auctions in the [ElunaAuctionSnapshot].
+     *
+     * @return uint32 count
+     */
+    int GetCount(Eluna* E, ElunaAuctionSnapshot* snapshot)
+    {
+        E->Push(uint32(snapshot->GetAuctions().size()));
+        return 1;
+    }
+
+    /**
+     * Returns the time the [ElunaAuctionSnapshot] was taken at, in seconds since epoch.
+     *
+     * @return uint32 time
+     */
+    int GetCreateTime(Eluna* E, ElunaAuctionSnapshot* snapshot)
+    {
+        E->Push(snapshot->createTime);
+        return 1;
+    }
+
+    /**
+     * Returns the auctions in the [ElunaAuctionSnapshot] that match the filter.
+     *
+     * Filtering is done natively. Filtering by entry only visits the auctions of that entry,
+     * which are returned from the lowest to the highest price.
+     *
+     * @table
+     * @columns [Filter, Type, Comment]
+     * @values [entry, uint32, "Item entry"]
+     * @values [seller, uint32, "Low GUID of the seller"]
+     * @values [house, uint32, "0 for Alliance, 1 for Horde or 2 for neutral auction house"]
+     * @values [minPrice, uint32, "Minimum buyout price of a single item"]
+     * @values [maxPrice, uint32, "Maximum buyout price of a single item"]
+     *
+     * Each auction is a table with the fields `id`, `house`, `entry`, `count`, `seller`, `bidder`, `startBid`, `bid`, `buyout`, `price` and `expireTime`.
+     * `price` is the buyout price of a single item.
+     *
+     *     local snapshot = GetAuctionSnapshot()
+     *     for _, auction in ipairs(snapshot:GetAuctions({ entry = 36908, maxPrice = 100000 })) do
+     *         print(auction.id, auction.count, auction.price)
+     *     end
+     *
+     * @param table filter = nil : filter the auctions have to match, refer to the table above
+     * @return table auctions : table of auction tables
+     */
+    int GetAuctions(Eluna* E, ElunaAuctionSnapshot* snapshot)
+    {
+        ElunaAuctionSnapshot::Filter filter;
+        if (!lua_isnoneornil(E->L, 2))
+        {
+            luaL_checktype(E->L, 2, LUA_TTABLE);
+            lua_getfield(E->L, 2, "entry");
+            filter.entry = E->CHECKVAL<uint32>(-1, 0);
+            lua_getfield(E->L, 2, "seller");
+            filter.seller = E->CHECKVAL<uint32>(-1, 0);
+            lua_getfield(E->L, 2, "house");
+            filter.house = E->CHECKVAL<int32>(-1, -1);
+            lua_getfield(E->L, 2, "minPrice");
+            filter.minPrice = E->CHECKVAL<uint32>(-1, 0);
+            lua_getfield(E->L, 2, "maxPrice");
+            filter.maxPrice = E->CHECKVAL<uint32>(-1, 0);
+            lua_pop(E->L, 5);
+        }
+
+        std::vector<ElunaAuction const*> result;
+        snapshot->Find(filter, result);
+
+        lua_createtable(E->L, int(result.size()), 0);
+        for (size_t i = 0; i < result.size(); ++i)
+        {
+            PushAuction(E, *result[i]);
+            lua_rawseti(E->L, -2, int(i + 1));
+        }
+        return 1;
+    }
+
+    /**
+     * Returns the item entries that have auctions in the [ElunaAuctionSnapshot], in ascending order.
+     *
+     * @return table entries
+     */
+    int GetEntries(Eluna* E, ElunaAuctionSnapshot* snapshot)
+    {
+        std::vector<ElunaAuction> const& auctions = snapshot->GetAuctions();
+
+        int index = 0;
+        lua_createtable(E->L, int(snapshot->GetEntryIndex().size()), 0);
+        for (size_t i = 0; i < auctions.size(); ++i)
+        {
+            if (i && auctions[i].entry == auctions[i - 1].entry)
+                continue;
+
+            E->Push(auctions[i].entry);
+            lua_rawseti(E->L, -2, ++index);
+        }
+        return 1;
+    }
+
+    /**
+     * Returns statistics of the auctions of an item entry in the [ElunaAuctionSnapshot].
+     *
+     * The statistics are a table with the fields `auctions`, `items`, `minPrice`, `medianPrice` and `maxPrice`.
+     * The prices are buyout prices of a single item and are 0 if none of the auctions have a buyout.
+     *
+     * @param uint32 entry : item entry
+     * @return table stats : statistics of the entry or nil if it has no auctions
+     */
+    int GetStats(Eluna* E, ElunaAuctionSnapshot* snapshot)
+    {
+        uint32 entry = E->CHECKVAL<uint32>(2);
+
+        ElunaAuctionStats stats;
+        if (!snapshot->GetStats(entry, stats))
+            return 1;
+
+        PushStats(E, stats);
+        return 1;
+    }
+
+    /**
+     * Returns statistics of the auctions of every item entry in the [ElunaAuctionSnapshot], see [ElunaAuctionSnapshot:GetStats].
+     *
+     *     for entry, stats in pairs(GetAuctionSnapshot():GetAllStats()) do
+     *         print(entry, stats.auctions, stats.medianPrice)
+     *     end
+     *
+     * @return table stats : table of statistics indexed by item entry
+     */
+    int GetAllStats(Eluna* E, ElunaAuctionSnapshot* snapshot)
+    {
+        lua_createtable(E->L, 0, int(snapshot->GetEntryIndex().size()));
+        for (auto const& itr : snapshot->GetEntryIndex())
+        {
+            ElunaAuctionStats stats;
+            snapshot->GetStats(itr.first, stats);
+
+            PushStats(E, stats);
+            lua_rawseti(E->L, -2, int(itr.first));
+        }
+        return 1;
+    }
+
+    ElunaRegister<ElunaAuctionSnapshot> AuctionSnapshotMethods[] =
+    {
+        // Getters
+        { "GetCount", &LuaAuctionSnapshot::GetCount },
+        { "GetCreateTime", &LuaAuctionSnapshot::GetCreateTime },
+        { "GetAuctions", &LuaAuctionSnapshot::GetAuctions },
+        { "GetEntries", &LuaAuctionSnapshot::GetEntries },
+        { "GetStats", &LuaAuctionSnapshot::GetStats },
+        { "GetAllStats", &LuaAuctionSnapshot::GetAllStats }
+    };
+};
+
+#endif
@@ -7,6 +7,7 @@
 #ifndef WORLDOBJECTMETHODS_H
 #define WORLDOBJECTMETHODS_H
 
+#include "ElunaObjectVariables.h"
 #include "LuaValue.h"
 
 /***
@@ -645,6 +646,39 @@ namespace LuaWorldObject
         return 1;
     }
 
+    static bool GetSpawnType(uint32 spawnType, TempSummonType& type)
+    {
+        switch (spawnType)
+        {
+            case 1:
+                type = TEMPSUMMON_TIMED_OR_DEAD_DESPAWN;
+                return true;
+            case 2:
+                type = TEMPSUMMON_TIMED_OR_CORPSE_DESPAWN;
+                return true;
+            case 3:
+                type = TEMPSUMMON_TIMED_DESPAWN;
+                return true;
+            case 4:
+                type = TEMPSUMMON_TIMED_DESPAWN_OUT_OF_COMBAT;
+                return true;
+            case 5:
+                type = TEMPSUMMON_CORPSE_DESPAWN;
+                return true;
+            case 6:
+                type = TEMPSUMMON_CORPSE_TIMED_DESPAWN;
+                return true;
+            case 7:
+                type = TEMPSUMMON_DEAD_DESPAWN;
+                return true;
+            case 8:
+                type = TEMPSUMMON_MANUAL_DESPAWN;
+                return true;
+            default:
+                return false;
+        }
+    }
+
     /**
      * Spawns the creature at specified location.
      *
@@ -681,37 +715,149 @@ namespace LuaWorldObject
         uint32 despawnTimer = E->CHECKVAL<uint32>(8, 0);
 
         TempSummonType type;
-        switch (spawnType)
+        if (!GetSpawnType(spawnType, type))
+            return luaL_argerror(E->L, 7, "valid SpawnType expected");
+
+        E->Push(obj->SummonCreature(entry, x, y, z, o, type, Milliseconds(despawnTimer)));
+        return 1;
+    }
+
+    static void ReadSpawnFormation(Eluna* E, WorldObject* obj, std::vector<uint32>& entries, std::vector<ElunaSpawnGroupMember>& members)
+    {
+        luaL_checktype(E->L, 3, LUA_TTABLE);
+        int count = lua_rawlen(E->L, 3);
+        bool entryList = lua_istable(E->L, 2);
+        uint32 entry = entryList ? 0 : E->CHECKVAL<uint32>(2);
+        if (entryList && int(lua_rawlen(E->L, 2)) != count)
+            luaL_argerror(E->L, 2, "one entry per offset expected");
+
+        entries.reserve(count);
+        members.reserve(count);
+        for (int i = 1; i <= count; ++i)
         {
-            case 1:
-                type = TEMPSUMMON_TIMED_OR_DEAD_DESPAWN;
-                break;
-            case 2:
-                type = TEMPSUMMON_TIMED_OR_CORPSE_DESPAWN;
-                break;
-            case 3:
-                type = TEMPSUMMON_TIMED_DESPAWN;
-                break;
-            case 4:
-                type = TEMPSUMMON_TIMED_DESPAWN_OUT_OF_COMBAT;
-                break;
-            case 5:
-                type = TEMPSUMMON_CORPSE_DESPAWN;
-                break;
-            case 6:
-                type = TEMPSUMMON_CORPSE_TIMED_DESPAWN;
-                break;
-            case 7:
-                type = TEMPSUMMON_DEAD_DESPAWN;
-                break;
-            case 8:
-                type = TEMPSUMMON_MANUAL_DESPAWN;
-                break;
-            default:
-                return luaL_argerror(E->L, 7, "valid SpawnType expected");
+            if (entryList)
+            {
+                lua_rawgeti(E->L, 2, i);
+                entry = E->CHECKVAL<uint32>(-1);
+                lua_pop(E->L, 1);
+            }
+
+            lua_rawgeti(E->L, 3, i);
+            if (!lua_istable(E->L, -1))
+                luaL_argerror(E->L, 3, "table of {x, y, z, o} offsets expected");
+
+            lua_rawgeti(E->L, -1, 1);
+            lua_rawgeti(E->L, -2, 2);
+            lua_rawgeti(E->L, -3, 3);
+            lua_rawgeti(E->L, -4, 4);
+
+            ElunaSpawnGroupMember member;
+            member.x = E->CHECKVAL<float>(-4);
+            member.y = E->CHECKVAL<float>(-3);
+            member.z = E->CHECKVAL<float>(-2, 0.0f);
+            member.o = E->CHECKVAL<float>(-1, 0.0f);
+            lua_pop(E->L, 5);
+
+            ElunaSpawnGroup::ApplyOffset(obj->GetPositionX(), obj->GetPositionY(), obj->GetPositionZ(), obj->GetOrientation(), member);
+            entries.push_back(entry);
+            members.push_back(member);
         }
+    }
 
-        E->Push(obj->SummonCreature(entry, x, y, z, o, type, Milliseconds(despawnTimer)));
+    /**
+     * Spawns a group of creatures in a formation around the [WorldObject] and returns them as an [ElunaSpawnGroup].
+     *
+     * Each offset is a table `{x, y, z, o}` relative to the [WorldObject]: x points in its facing direction, y to its left and z up.
+     * The optional o is added to the facing of the [WorldObject]. The whole formation turns with the [WorldObject].
+     * Creatures that fail to spawn are left out of the group.
+     *
+     * Spawning with [TempSummonType] MANUAL_DESPAWN keeps dead creatures around, so the group can be reused with [ElunaSpawnGroup:Respawn]
+     * instead of spawning new creatures for every wave.
+     *
+     *     -- three guards in a row behind the player
+     *     local group = player:SpawnCreatures(68, { { -3, -2 }, { -3, 0 }, { -3, 2 } })
+     *     -- a leader with two different adds at its sides
+     *     local wave = creature:SpawnCreatures({ 1000, 1001, 1001 }, { { 5, 0 }, { 3, 3, 0, 0.5 }, { 3, -3, 0, -0.5 } }, 8)
+     *
+     * @param uint32/table entry : [Creature] entry ID used for all offsets, or a table of entry IDs with one for each offset
+     * @param table offsets : a table of `{x, y, z, o}` offsets, z and o default to 0
+     * @param [TempSummonType] spawnType = MANUAL_DESPAWN : defines how and when the creatures despawn, see [WorldObject:SpawnCreature]
+     * @param uint32 despawnTimer = 0 : despawn time in milliseconds
+     * @return [ElunaSpawnGroup] group
+     */
+    int SpawnCreatures(Eluna* E, WorldObject* obj)
+    {
+        std::vector<uint32> entries;
+        ElunaSpawnGroup group(obj->GetMapId(), obj->GetInstanceId());
+        ReadSpawnFormation(E, obj, entries, group.creatures);
+        uint32 spawnType = E->CHECKVAL<uint32>(4, 8);
+        uint32 despawnTimer = E->CHECKVAL<uint32>(5, 0);
+
+        TempSummonType type;
+        if (!GetSpawnType(spawnType, type))
+            return luaL_argerror(E->L, 4, "valid SpawnType expected");
+
+        size_t spawned = 0;
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            ElunaSpawnGroupMember member = group.creatures[i];
+            uint32 entry = entries[i];
+            float x = member.x;
+            float y = member.y;
+            float z = member.z;
+            float o = member.o;
+
+            Creature* creature = obj->SummonCreature(entry, x, y, z, o, type, Milliseconds(despawnTimer));
+            if (!creature)
+                continue;
+
+            member.guid = creature->GET_GUID();
+            group.creatures[spawned++] = member;
+        }
+        group.creatures.resize(spawned);
+
+        E->Push(&group);
+        return 1;
+    }
+
+    /**
+     * Spawns a group of game objects in a formation around the [WorldObject] and returns them as an [ElunaSpawnGroup].
+     *
+     * The offsets work the same way as for [WorldObject:SpawnCreatures]. Game objects that fail to spawn are left out of the group.
+     *
+     * @param uint32/table entry : [GameObject] entry ID used for all offsets, or a table of entry IDs with one for each offset
+     * @param table offsets : a table of `{x, y, z, o}` offsets, z and o default to 0
+     * @param uint32 respawnDelay = 30 : respawn time in seconds
+     * @return [ElunaSpawnGroup] group
+     */
+    int SpawnGameObjects(Eluna* E, WorldObject* obj)
+    {
+        std::vector<uint32> entries;
+        ElunaSpawnGroup group(obj->GetMapId(), obj->GetInstanceId());
+        ReadSpawnFormation(E, obj, entries, group.gameObjects);
+        uint32 respawnDelay = E->CHECKVAL<uint32>(4, 30);
+
+        size_t spawned = 0;
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            ElunaSpawnGroupMember member = group.gameObjects[i];
+            uint32 entry = entries[i];
+            float x = member.x;
+            float y = member.y;
+            float z = member.z;
+            float o = member.o;
+            QuaternionData rot = QuaternionData::fromEulerAnglesZYX(o, 0.f, 0.f);
+
+            GameObject* object = obj->SummonGameObject(entry, Position(x, y, z, o), rot, Seconds(respawnDelay));
+            if (!object)
+                continue;
+
+            member.guid = object->GET_GUID();
+            group.gameObjects[spawned++] = member;
+        }
+        group.gameObjects.resize(spawned);
+
+        E->Push(&group);
         return 1;
     }
 
@@ -762,13 +908,13 @@ namespace LuaWorldObject
             return luaL_argerror(E->L, 3, "min is bigger than max delay");
 
         lua_pushvalue(E->L, 2);
-        int functionRef = luaL_ref(E->L, LUA_REGISTRYINDEX);
+        int functionRef = ELUNA_REF(E->L, ELUNA_REF_TIMED_EVENT);
         if (functionRef != LUA_REFNIL && functionRef != LUA_NOREF)
         {
             ElunaEventProcessor* proc = obj->GetElunaEvents(E->GetBoundMapId());
             if (!proc)
             {
-                luaL_unref(E->L, LUA_REGISTRYINDEX, functionRef);
+                ELUNA_UNREF(E->L, functionRef);
                 E->Push();
                 return 1;
             }
@@ -1140,6 +1286,62 @@ namespace LuaWorldObject
         return LuaVal::PushLuaVal(E->L, obj->lua_data);
     }
     
+    static ElunaObjectVariables::Key GetVariablesKey(Eluna* E, WorldObject* obj)
+    {
+        switch (obj->GetTypeId())
+        {
+            case TYPEID_PLAYER:
+                // Player variables are kept over map changes until logout
+                return { ElunaObjectVariables::PLAYER_MAP_ID, 0, obj->GET_GUID().GetRawValue() };
+            case TYPEID_UNIT:
+            case TYPEID_GAMEOBJECT:
+                return { obj->GetMapId(), obj->GetInstanceId(), obj->GET_GUID().GetRawValue() };
+            default:
+                luaL_argerror(E->L, 1, "Player, Creature or GameObject expected");
+                return {};
+        }
+    }
+
+    /**
+     * Returns a variable set with [WorldObject:SetData], or a table of all variables of the [WorldObject] if no field is given.
+     *
+     * Variables are available for players, creatures and game objects. They can hold any Lua value
+     *   and are kept by the Lua state until the object is removed from the world, the [Player] logs out
+     *   or the [Map] is created or destroyed. A reload of the Lua state clears them.
+     *
+     * Changes made to the returned table are kept.
+     *
+     *     creature:SetData("phase", 2)
+     *     local phase = creature:GetData("phase")
+     *
+     * @param string field = nil : name of the variable
+     * @return any value : value of the variable, or a table of all variables if no field is given
+     */
+    int GetData(Eluna* E, WorldObject* obj)
+    {
+        if (lua_isnoneornil(E->L, 2))
+            E->objectVariables->PushTable(GetVariablesKey(E, obj));
+        else
+            E->objectVariables->Push(GetVariablesKey(E, obj), 2);
+        return 1;
+    }
+
+    /**
+     * Sets a variable of the [WorldObject], see [WorldObject:GetData].
+     *
+     * @param string field : name of the variable
+     * @param any value : new value of the variable, nil removes it
+     */
+    int SetData(Eluna* E, WorldObject* obj)
+    {
+        if (lua_isnoneornil(E->L, 2))
+            return luaL_argerror(E->L, 2, "field expected");
+
+        lua_settop(E->L, 3);
+        E->objectVariables->Set(GetVariablesKey(E, obj), 2, 3);
+        return 0;
+    }
+
     ElunaRegister<WorldObject> WorldObjectMethods[] =
     {
         // Getters
@@ -1185,8 +1387,12 @@ namespace LuaWorldObject
         { "IsInBack", &LuaWorldObject::IsInBack },
 
         // Other
+        { "GetData", &LuaWorldObject::GetData },
+        { "SetData", &LuaWorldObject::SetData },
         { "SummonGameObject", &LuaWorldObject::SummonGameObject },
         { "SpawnCreature", &LuaWorldObject::SpawnCreature },
+        { "SpawnCreatures", &LuaWorldObject::SpawnCreatures },
+        { "SpawnGameObjects", &LuaWorldObject::SpawnGameObjects },
         { "SendPacket", &LuaWorldObject::SendPacket },
         { "RegisterEvent", &LuaWorldObject::RegisterEvent },
         { "RemoveEventById", &LuaWorldObject::RemoveEventById },
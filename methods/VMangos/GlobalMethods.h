@@ -8,6 +8,14 @@
 #define GLOBALMETHODS_H
 
 #include "BindingMap.h"
+#include "ElunaBenchmark.h"
+#include "ElunaChatFilter.h"
+#include "ElunaChromeTrace.h"
+#include "ElunaCommandMgr.h"
+#include "ElunaHeapCensus.h"
+#include "ElunaHookTrace.h"
+#include "ElunaScriptProfiler.h"
+#include "ElunaStringCache.h"
 
 /***
  * These functions can be used anywhere at any time, including at start-up.
@@ -346,9 +354,115 @@ namespace LuaGlobalFunctions
         return 1;
     }
 
+    static bool BuildCachedString(ElunaStringCache::Kind kind, uint32 entry, uint8 locale, std::string& value)
+    {
+        switch (kind)
+        {
+            case ElunaStringCache::ITEM_LINK:
+            case ElunaStringCache::ITEM_NAME:
+            {
+                const ItemTemplate* temp = eObjectMgr->GetItemTemplate(entry);
+                if (!temp)
+                    return false;
+
+                std::string name = temp->Name1;
+                if (ItemLocale const* il = eObjectMgr->GetItemLocale(entry))
+                    name = il->Name[locale];
+
+                if (kind == ElunaStringCache::ITEM_NAME)
+                {
+                    value = name;
+                    return true;
+                }
+
+                std::ostringstream oss;
+                oss << "|c" << std::hex << ItemQualityColors[temp->Quality] << std::dec <<
+                    "|Hitem:" << entry << ":0:" <<
+                    "0:0:0:0|h[" << name << "]|h|r";
+
+                value = oss.str();
+                return true;
+            }
+            case ElunaStringCache::SPELL_LINK:
+            {
+                SpellEntry const* spellEntry = sSpellMgr.GetSpellEntry(entry);
+                if (!spellEntry)
+                    return false;
+
+                std::string name = spellEntry->SpellName[locale < MAX_DBC_LOCALE ? locale : DEFAULT_LOCALE];
+                if (name.empty())
+                    name = spellEntry->SpellName[DEFAULT_LOCALE];
+
+                std::ostringstream oss;
+                oss << "|cff71d5ff|Hspell:" << entry << "|h[" << name << "]|h|r";
+
+                value = oss.str();
+                return true;
+            }
+            case ElunaStringCache::QUEST_LINK:
+            {
+                Quest const* quest = eObjectMgr->GetQuestTemplate(entry);
+                if (!quest)
+                    return false;
+
+                std::string title = quest->GetTitle();
+                if (QuestLocale const* ql = eObjectMgr->GetQuestLocale(entry))
+                    if (ql->Title.size() > locale && !ql->Title[locale].empty())
+                        title = ql->Title[locale];
+
+                std::ostringstream oss;
+                oss << "|cffffff00|Hquest:" << entry << ":" << quest->GetQuestLevel() << "|h[" << title << "]|h|r";
+
+                value = oss.str();
+                return true;
+            }
+            case ElunaStringCache::CREATURE_NAME:
+            {
+                CreatureInfo const* creatureTemplate = sObjectMgr.GetCreatureTemplate(entry);
+                if (!creatureTemplate)
+                    return false;
+
+                value = creatureTemplate->Name;
+                if (CreatureLocale const* cl = eObjectMgr->GetCreatureLocale(entry))
+                    if (cl->Name.size() > locale && !cl->Name[locale].empty())
+                        value = cl->Name[locale];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static std::string const* GetCachedString(Eluna* E, ElunaStringCache::Kind kind, uint32 entry, uint8 locale)
+    {
+        if (std::string const* value = E->stringCache->Find(kind, entry, locale))
+            return value;
+
+        std::string value;
+        if (!BuildCachedString(kind, entry, locale, value))
+            return nullptr;
+
+        return &E->stringCache->Insert(kind, entry, locale, value);
+    }
+
+    static int PushCachedString(Eluna* E, ElunaStringCache::Kind kind, const char* entryError)
+    {
+        uint32 entry = E->CHECKVAL<uint32>(1);
+        uint8 locale = E->CHECKVAL<uint8>(2, DEFAULT_LOCALE);
+        if (locale >= TOTAL_LOCALES)
+            return luaL_argerror(E->L, 2, "valid LocaleConstant expected");
+
+        if (!GetCachedString(E, kind, entry, locale))
+            return luaL_argerror(E->L, 1, entryError);
+
+        E->stringCache->Push(kind, entry, locale);
+        return 1;
+    }
+
     /**
      * Returns an chat link for an [Item].
      *
+     * Links are built once per entry and locale and then cached, see [Global:ClearStringCache].
+     *
      *     enum LocaleConstant
      *     {
      *         LOCALE_enUS = 0,
@@ -368,28 +482,158 @@ namespace LuaGlobalFunctions
      */
     int GetItemLink(Eluna* E)
     {
-        uint32 entry = E->CHECKVAL<uint32>(1);
+        return PushCachedString(E, ElunaStringCache::ITEM_LINK, "valid ItemEntry expected");
+    }
+
+    /**
+     * Returns the name of an [Item] entry in the given locale.
+     *
+     * The name is cached per entry and locale, see [Global:GetItemLink].
+     *
+     * @param uint32 entry : entry ID of an [Item]
+     * @param [LocaleConstant] locale = DEFAULT_LOCALE : locale to return the [Item] name in, see [Global:GetItemLink]
+     * @return string name
+     */
+    int GetItemName(Eluna* E)
+    {
+        return PushCachedString(E, ElunaStringCache::ITEM_NAME, "valid ItemEntry expected");
+    }
+
+    /**
+     * Returns a chat link for a spell.
+     *
+     * The link is cached per entry and locale, see [Global:GetItemLink].
+     *
+     * @param uint32 entry : entry ID of a spell
+     * @param [LocaleConstant] locale = DEFAULT_LOCALE : locale to return the spell name in, see [Global:GetItemLink]
+     * @return string spellLink
+     */
+    int GetSpellLink(Eluna* E)
+    {
+        return PushCachedString(E, ElunaStringCache::SPELL_LINK, "valid SpellEntry expected");
+    }
+
+    /**
+     * Returns a chat link for a [Quest].
+     *
+     * The link is cached per entry and locale, see [Global:GetItemLink].
+     *
+     * @param uint32 entry : entry ID of a [Quest]
+     * @param [LocaleConstant] locale = DEFAULT_LOCALE : locale to return the [Quest] title in, see [Global:GetItemLink]
+     * @return string questLink
+     */
+    int GetQuestLink(Eluna* E)
+    {
+        return PushCachedString(E, ElunaStringCache::QUEST_LINK, "valid QuestEntry expected");
+    }
+
+    /**
+     * Returns the name of a [Creature] entry in the given locale.
+     *
+     * The name is cached per entry and locale, see [Global:GetItemLink].
+     *
+     * @param uint32 entry : entry ID of a [Creature]
+     * @param [LocaleConstant] locale = DEFAULT_LOCALE : locale to return the [Creature] name in, see [Global:GetItemLink]
+     * @return string name
+     */
+    int GetCreatureName(Eluna* E)
+    {
+        return PushCachedString(E, ElunaStringCache::CREATURE_NAME, "valid CreatureEntry expected");
+    }
+
+    /**
+     * Replaces link tokens in a string with cached chat links and names.
+     *
+     * Tokens that are unknown or have an invalid entry are left as they are.
+     *
+     * @table
+     * @columns [Token, Replaced with]
+     * @values [{item:entry}, "[Global:GetItemLink]"]
+     * @values [{itemname:entry}, "[Global:GetItemName]"]
+     * @values [{spell:entry}, "[Global:GetSpellLink]"]
+     * @values [{quest:entry}, "[Global:GetQuestLink]"]
+     * @values [{creature:entry}, "[Global:GetCreatureName]"]
+     *
+     *     SendWorldMessage(FormatLinks("{creature:36597} dropped {item:50818}!"))
+     *
+     * @param string text : text with link tokens
+     * @param [LocaleConstant] locale = DEFAULT_LOCALE : locale of the links and names, see [Global:GetItemLink]
+     * @return string text
+     */
+    int FormatLinks(Eluna* E)
+    {
+        std::string text = E->CHECKVAL<std::string>(1);
         uint8 locale = E->CHECKVAL<uint8>(2, DEFAULT_LOCALE);
         if (locale >= TOTAL_LOCALES)
             return luaL_argerror(E->L, 2, "valid LocaleConstant expected");
 
-        const ItemTemplate* temp = eObjectMgr->GetItemTemplate(entry);
-        if (!temp)
-            return luaL_argerror(E->L, 1, "valid ItemEntry expected");
+        static const std::pair<std::string, ElunaStringCache::Kind> tokens[] =
+        {
+            { "item", ElunaStringCache::ITEM_LINK },
+            { "itemname", ElunaStringCache::ITEM_NAME },
+            { "spell", ElunaStringCache::SPELL_LINK },
+            { "quest", ElunaStringCache::QUEST_LINK },
+            { "creature", ElunaStringCache::CREATURE_NAME }
+        };
+
+        std::string result;
+        result.reserve(text.size());
+
+        size_t pos = 0;
+        while (pos < text.size())
+        {
+            size_t open = text.find('{', pos);
+            size_t close = open == std::string::npos ? std::string::npos : text.find('}', open);
+            if (close == std::string::npos)
+            {
+                result.append(text, pos, std::string::npos);
+                break;
+            }
 
-        std::string name = temp->Name1;
-        if (ItemLocale const* il = eObjectMgr->GetItemLocale(entry))
-            name = il->Name[locale];
+            result.append(text, pos, open - pos);
 
-        std::ostringstream oss;
-        oss << "|c" << std::hex << ItemQualityColors[temp->Quality] << std::dec <<
-            "|Hitem:" << entry << ":0:" <<
-            "0:0:0:0|h[" << name << "]|h|r";
+            std::string const* value = nullptr;
+            size_t colon = text.find(':', open);
+            if (colon < close && colon + 1 < close)
+            {
+                char* end = nullptr;
+                unsigned long entry = strtoul(text.c_str() + colon + 1, &end, 10);
+                if (end == text.c_str() + close)
+                {
+                    for (auto const& token : tokens)
+                    {
+                        if (text.compare(open + 1, colon - open - 1, token.first) == 0)
+                        {
+                            value = GetCachedString(E, token.second, uint32(entry), locale);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if (value)
+                result += *value;
+            else
+                result.append(text, open, close - open + 1);
+
+            pos = close + 1;
+        }
 
-        E->Push(oss.str());
+        E->Push(result);
         return 1;
     }
 
+    /**
+     * Clears the cache of chat links and names used by [Global:GetItemLink], [Global:FormatLinks] and the other link functions.
+     *
+     * The cache only needs to be cleared after item, spell, quest or creature templates are reloaded.
+     */
+    int ClearStringCache(Eluna* E)
+    {
+        E->stringCache->Clear();
+        return 0;
+    }
+
     /**
      * Returns the type ID from a GUID.
      *
@@ -493,7 +737,7 @@ namespace LuaGlobalFunctions
         uint32 shots = E->CHECKVAL<uint32>(4, 0);
 
         lua_pushvalue(E->L, 3);
-        int functionRef = luaL_ref(E->L, LUA_REGISTRYINDEX);
+        int functionRef = ELUNA_REF(E->L, ELUNA_REF_BINDING);
         if (functionRef >= 0)
             return E->Register(regtype, id, ObjectGuid(), 0, ev, functionRef, shots);
         else
@@ -508,7 +752,7 @@ namespace LuaGlobalFunctions
         uint32 shots = E->CHECKVAL<uint32>(3, 0);
 
         lua_pushvalue(E->L, 2);
-        int functionRef = luaL_ref(E->L, LUA_REGISTRYINDEX);
+        int functionRef = ELUNA_REF(E->L, ELUNA_REF_BINDING);
         if (functionRef >= 0)
             return E->Register(regtype, 0, ObjectGuid(), 0, ev, functionRef, shots);
         else
@@ -525,7 +769,7 @@ namespace LuaGlobalFunctions
         uint32 shots = E->CHECKVAL<uint32>(5, 0);
 
         lua_pushvalue(E->L, 4);
-        int functionRef = luaL_ref(E->L, LUA_REGISTRYINDEX);
+        int functionRef = ELUNA_REF(E->L, ELUNA_REF_BINDING);
         if (functionRef >= 0)
             return E->Register(regtype, 0, guid, instanceId, ev, functionRef, shots);
         else
@@ -1172,6 +1416,160 @@ namespace LuaGlobalFunctions
         return RegisterEntryHelper(E, Hooks::REGTYPE_GAMEOBJECT);
     }
 
+    static int CancelCommand(lua_State* L)
+    {
+        Eluna* E = Eluna::GetEluna(L);
+
+        uint64 commandID = E->CHECKVAL<uint64>(lua_upvalueindex(1));
+        E->commandMgr->Remove(commandID);
+        return 0;
+    }
+
+    /**
+     * Registers a command handler.
+     *
+     * Commands registered this way are matched natively, so only the handler of the matching command is called
+     * and no Lua code runs for other commands. Command words can be abbreviated as long as they are unambiguous.
+     * If no registered command matches, or the invoker's security level is too low, the command is passed on
+     * to `PLAYER_EVENT_ON_COMMAND` handlers and the core as usual.
+     *
+     * The argument specification is a space separated list of argument types. Appending `?` makes an argument optional,
+     * optional arguments must come last and are passed as `nil` when missing.
+     * If the arguments do not match the specification, the handler is not called and the usage is sent to the invoker.
+     *
+     * @table
+     * @columns [Type, Lua value, Comment]
+     * @values [int, number, "Signed integer"]
+     * @values [uint, number, "Unsigned integer"]
+     * @values [number, number, "Any number"]
+     * @values [player, Player, "Name of an online player"]
+     * @values [string, string, "Single word or a \"quoted string\""]
+     * @values [link, number, "Id from a chat link such as an item link, or a plain id. Use link:item, link:spell, etc. to require a link type"]
+     * @values [rest, string, "The rest of the command line, must be the last argument"]
+     *
+     *     RegisterCommand("event start", 2, "uint string?", function(player, eventId, comment)
+     *         -- player is nil when the command is used from the console
+     *     end)
+     *
+     * In multistate, this method is only available in the WORLD state
+     *
+     * @param string path : the command, for example "event start"
+     * @param uint32 security : minimum account security level required to use the command
+     * @param string argSpec : argument specification, refer to the table above
+     * @param function function : function that will be called with the invoking player followed by the parsed arguments
+     *
+     * @return function cancel : a function that removes the command when called
+     */
+    int RegisterCommand(Eluna* E)
+    {
+        std::string path = E->CHECKVAL<std::string>(1);
+        uint32 security = E->CHECKVAL<uint32>(2);
+        std::string argSpec = E->CHECKVAL<std::string>(3);
+        luaL_checktype(E->L, 4, LUA_TFUNCTION);
+
+        std::vector<ElunaCommandArg> args;
+        std::string error;
+        if (!ElunaCommandMgr::ParseArgSpec(argSpec, args, error))
+            return luaL_argerror(E->L, 3, error.c_str());
+
+        lua_pushvalue(E->L, 4);
+        int functionRef = ELUNA_REF(E->L, ELUNA_REF_COMMAND);
+        if (functionRef < 0)
+            return luaL_argerror(E->L, 4, "unable to make a ref to function");
+
+        uint64 commandID = E->commandMgr->Insert(path, security, std::move(args), functionRef);
+        if (!commandID)
+            return luaL_argerror(E->L, 1, "non empty command path expected");
+
+        E->Push(commandID);
+        lua_pushcclosure(E->L, &CancelCommand, 1);
+        return 1;
+    }
+
+    static int CancelChatFilter(lua_State* L)
+    {
+        Eluna* E = Eluna::GetEluna(L);
+
+        uint64 filterID = E->CHECKVAL<uint64>(lua_upvalueindex(1));
+        E->chatFilterMgr->Remove(filterID);
+        return 0;
+    }
+
+    /**
+     * Registers a chat filter for the given [Player] chat events.
+     *
+     * The message is searched natively for all words in the list at once, the handler is only called
+     * for messages that contain at least one of the words. Matching ignores case, common leetspeak substitutions,
+     * punctuation inside words and repeated characters, so "b.@.aaad" matches the word "bad".
+     *
+     * Filters run before the handlers registered with [Global:RegisterPlayerEvent] for the same event.
+     * Like those handlers, the filter handler can return `false` to prevent the message from being sent
+     * and a string to replace the message.
+     *
+     * Each match is a table with the fields `start` and `stop`, the positions of the match in the message
+     * as returned by `string.find`, and `word`, the matched word from the list.
+     *
+     *     RegisterChatFilter({ 18, 19, 22 }, { "badword", "gold for sale" }, function(event, player, msg, matches, type, lang, target)
+     *         for _, match in ipairs(matches) do
+     *             msg = msg:sub(1, match.start - 1) .. ("*"):rep(match.stop - match.start + 1) .. msg:sub(match.stop + 1)
+     *         end
+     *         return true, msg
+     *     end)
+     *
+     * In multistate, this method is only available in the WORLD state
+     *
+     * @proto cancel = (events, words, function)
+     * @proto cancel = (events, words, function, wholeWords)
+     * @param uint32/table events : a chat event ID or a table of them: 18 (on_chat), 19 (on_whisper), 20 (on_group_chat), 21 (on_guild_chat) or 22 (on_channel_chat)
+     * @param table words : a table of the words and phrases to search for
+     * @param function function : the function that will be called with the event ID, the [Player], the message, a table of matches, the chat type, the language and the receiver, [Group], [Guild] or channel ID if the event has one
+     * @param bool wholeWords = false : if `true`, only matches that are not part of a longer word are reported
+     *
+     * @return function cancel : a function that removes the filter when called
+     */
+    int RegisterChatFilter(Eluna* E)
+    {
+        uint32 events = 0;
+        if (lua_istable(E->L, 1))
+        {
+            lua_pushnil(E->L);
+            while (lua_next(E->L, 1))
+            {
+                uint32 mask = ElunaChatFilterMgr::GetEventMask(E->CHECKVAL<uint32>(-1));
+                if (!mask)
+                    return luaL_argerror(E->L, 1, "chat event ID expected");
+                events |= mask;
+                lua_pop(E->L, 1);
+            }
+        }
+        else
+            events = ElunaChatFilterMgr::GetEventMask(E->CHECKVAL<uint32>(1));
+
+        if (!events)
+            return luaL_argerror(E->L, 1, "chat event ID expected");
+
+        luaL_checktype(E->L, 2, LUA_TTABLE);
+        luaL_checktype(E->L, 3, LUA_TFUNCTION);
+        bool wholeWords = E->CHECKVAL<bool>(4, false);
+
+        std::vector<std::string> words;
+        for (int i = 1, count = lua_rawlen(E->L, 2); i <= count; ++i)
+        {
+            lua_rawgeti(E->L, 2, i);
+            words.push_back(E->CHECKVAL<std::string>(-1));
+            lua_pop(E->L, 1);
+        }
+
+        lua_pushvalue(E->L, 3);
+        int functionRef = ELUNA_REF(E->L, ELUNA_REF_CHAT_FILTER);
+        if (functionRef < 0)
+            return luaL_argerror(E->L, 3, "unable to make a ref to function");
+
+        E->Push(E->chatFilterMgr->Add(events, words, wholeWords, functionRef));
+        lua_pushcclosure(E->L, &CancelChatFilter, 1);
+        return 1;
+    }
+
     /**
      * Reloads the Lua engine.
      */
@@ -1181,6 +1579,267 @@ namespace LuaGlobalFunctions
         return 0;
     }
 
+    /**
+     * Runs the engine microbenchmarks and returns the average time of one iteration of each in nanoseconds.
+     *
+     * The benchmarks measure hook dispatch, pushing and checking objects, calling an object method, value marshalling and timed event scheduling.
+     * Built against LuaJIT, they also measure calling the same getter through the ElunaFFI table.
+     * They use their own empty handlers, so handlers registered by scripts are not called.
+     * The object benchmarks are only run when a [WorldObject] is given. The server waits for the benchmarks to finish.
+     *
+     *     for name, ns in pairs(RunBenchmarks(player, 100000)) do
+     *         print(name, ns)
+     *     end
+     *
+     * @param [WorldObject] obj = nil : object used by the object benchmarks
+     * @param uint32 iterations = 100000 : iterations of each benchmark
+     * @return table results : benchmark names with the nanoseconds one iteration took
+     */
+    int RunBenchmarks(Eluna* E)
+    {
+        WorldObject* obj = E->CHECKOBJ<WorldObject>(1, false);
+        uint32 iterations = E->CHECKVAL<uint32>(2, 100000);
+
+        lua_newtable(E->L);
+        for (ElunaBenchmark::Result const& result : ElunaBenchmark::Run(E, obj, iterations))
+        {
+            E->Push(result.nanoseconds);
+            lua_setfield(E->L, -2, result.name.c_str());
+        }
+        return 1;
+    }
+
+    /**
+     * Starts recording the hook calls of the current state to a file. Traces are replayed with tools/mockhost.
+     *
+     * Every hook call is recorded with its arguments, and every handler with its results and run time.
+     * A trace that is already running is stopped first. Recording stops by itself once the file reaches `maxBytes`.
+     *
+     * @param string path : file to write the trace to
+     * @param uint32 maxBytes = 67108864 : size limit of the file
+     * @return bool started : false if the file could not be opened
+     */
+    int StartHookTrace(Eluna* E)
+    {
+        std::string path = E->CHECKVAL<std::string>(1);
+        uint32 maxBytes = E->CHECKVAL<uint32>(2, 64 * 1024 * 1024);
+
+        E->hookTrace.reset();
+        E->hookTrace = std::make_unique<ElunaHookTrace>(E, path, maxBytes);
+        if (!E->hookTrace->IsOpen())
+            E->hookTrace.reset();
+
+        E->Push(E->hookTrace != nullptr);
+        return 1;
+    }
+
+    /**
+     * Stops recording hook calls and writes the rest of the trace to its file.
+     */
+    int StopHookTrace(Eluna* E)
+    {
+        E->hookTrace.reset();
+        return 0;
+    }
+
+    /**
+     * Returns the handler run time, calls and allocated bytes of each script file of the current state.
+     *
+     * Each entry is a table with the fields `path`, `calls`, `time` in milliseconds and `allocated` in bytes,
+     * sorted by time. Handlers are counted for the script that registered them, and their time includes handlers they call.
+     * Needs `Eluna.ScriptProfiling` to be enabled, otherwise the table is empty.
+     *
+     *     for _, script in ipairs(GetScriptProfile()) do
+     *         print(script.path, script.calls, script.time, script.allocated)
+     *     end
+     *
+     * @return table scripts
+     */
+    int GetScriptProfile(Eluna* E)
+    {
+        lua_newtable(E->L);
+        if (!E->scriptProfiler)
+            return 1;
+
+        int i = 0;
+        for (ElunaScriptProfiler::Script const& script : E->scriptProfiler->GetScripts())
+        {
+            lua_createtable(E->L, 0, 4);
+            E->Push(script.path);
+            lua_setfield(E->L, -2, "path");
+            E->Push(double(script.calls));
+            lua_setfield(E->L, -2, "calls");
+            E->Push(script.time / 1000.0);
+            lua_setfield(E->L, -2, "time");
+            E->Push(double(script.allocated));
+            lua_setfield(E->L, -2, "allocated");
+            lua_rawseti(E->L, -2, ++i);
+        }
+        return 1;
+    }
+
+    /**
+     * Resets the script profile of the current state, see [Global:GetScriptProfile].
+     */
+    int ResetScriptProfile(Eluna* E)
+    {
+        if (E->scriptProfiler)
+            E->scriptProfiler->Reset();
+        return 0;
+    }
+
+    /**
+     * Counts the objects reachable from the globals and the registry of the current state by type, and finds its largest tables.
+     *
+     * Eluna objects are counted under their type name, like `Player`. Bytes are estimates, except for `heap`, the real size of the state.
+     * The walk stops after examining `budget` values and sets `complete` to false, so the server is only held up for a bounded time.
+     *
+     * The returned table has the fields `complete`, `examined`, `heap`, `types`, a table of type names with `count` and `bytes` fields,
+     * and `tables`, an array of the largest tables with `path`, `entries` and `bytes` fields. Paths are the shortest ones from `_G` or the `registry`.
+     * After the first census, `diff` holds the change of `count` and `bytes` of each type since the previous census of the state.
+     *
+     *     local census = GetHeapCensus(1000000, 5)
+     *     for _, t in ipairs(census.tables) do
+     *         print(t.path, t.entries, t.bytes)
+     *     end
+     *     for name, change in pairs(census.diff or {}) do
+     *         print(name, change.count, change.bytes)
+     *     end
+     *
+     * @param uint32 budget = 1000000 : values to examine at most
+     * @param uint32 largestTables = 10 : largest tables to return
+     * @return table census
+     */
+    int GetHeapCensus(Eluna* E)
+    {
+        uint32 budget = E->CHECKVAL<uint32>(1, 1000000);
+        uint32 largestTables = E->CHECKVAL<uint32>(2, 10);
+
+        std::unique_ptr<ElunaHeapCensus> census = std::make_unique<ElunaHeapCensus>(E->L, budget, largestTables);
+
+        lua_createtable(E->L, 0, 6);
+        E->Push(census->IsComplete());
+        lua_setfield(E->L, -2, "complete");
+        E->Push(census->GetExamined());
+        lua_setfield(E->L, -2, "examined");
+        E->Push(double(census->GetHeapBytes()));
+        lua_setfield(E->L, -2, "heap");
+
+        lua_newtable(E->L);
+        for (auto const& type : census->GetTypes())
+        {
+            lua_createtable(E->L, 0, 2);
+            E->Push(double(type.second.count));
+            lua_setfield(E->L, -2, "count");
+            E->Push(double(type.second.bytes));
+            lua_setfield(E->L, -2, "bytes");
+            lua_setfield(E->L, -2, type.first.c_str());
+        }
+        lua_setfield(E->L, -2, "types");
+
+        lua_newtable(E->L);
+        int i = 0;
+        for (ElunaHeapCensus::Table const& table : census->GetLargestTables())
+        {
+            lua_createtable(E->L, 0, 3);
+            E->Push(table.path);
+            lua_setfield(E->L, -2, "path");
+            E->Push(double(table.entries));
+            lua_setfield(E->L, -2, "entries");
+            E->Push(double(table.bytes));
+            lua_setfield(E->L, -2, "bytes");
+            lua_rawseti(E->L, -2, ++i);
+        }
+        lua_setfield(E->L, -2, "tables");
+
+        if (E->heapCensus)
+        {
+            std::map<std::string, ElunaHeapCensus::TypeStats> const& before = E->heapCensus->GetTypes();
+            std::map<std::string, ElunaHeapCensus::TypeStats> const& after = census->GetTypes();
+            std::map<std::string, std::pair<double, double>> changes;
+            for (auto const& type : after)
+                changes[type.first] = { double(type.second.count), double(type.second.bytes) };
+            for (auto const& type : before)
+            {
+                changes[type.first].first -= double(type.second.count);
+                changes[type.first].second -= double(type.second.bytes);
+            }
+
+            lua_newtable(E->L);
+            for (auto const& change : changes)
+            {
+                if (!change.second.first && !change.second.second)
+                    continue;
+
+                lua_createtable(E->L, 0, 2);
+                E->Push(change.second.first);
+                lua_setfield(E->L, -2, "count");
+                E->Push(change.second.second);
+                lua_setfield(E->L, -2, "bytes");
+                lua_setfield(E->L, -2, change.first.c_str());
+            }
+            lua_setfield(E->L, -2, "diff");
+        }
+
+        E->heapCensus = std::move(census);
+        return 1;
+    }
+
+    /**
+     * Returns the number of live registry references of the current state by owner, like `binding`, `timed_event` or `query_callback`.
+     *
+     * References are only tracked in debug builds and builds with `ELUNA_TRACK_REFS` defined, otherwise nil is returned.
+     * References still alive when the state closes are logged with the place they were created at.
+     *
+     * @return table counts : owner categories with their reference counts, or nil
+     */
+    int GetRegistryRefCounts(Eluna* E)
+    {
+        if (!E->refTracker)
+            return 0;
+
+        lua_createtable(E->L, 0, ELUNA_REF_CATEGORY_COUNT);
+        for (uint8 i = 0; i < ELUNA_REF_CATEGORY_COUNT; ++i)
+        {
+            ElunaRefCategory category = ElunaRefCategory(i);
+            E->Push(E->refTracker->GetCount(category));
+            lua_setfield(E->L, -2, ElunaRefTracker::GetCategoryName(category));
+        }
+        return 1;
+    }
+
+    /**
+     * Starts writing the Lua activity of all states to `path` in the Chrome trace event format.
+     *
+     * The trace records hook dispatches, handler calls, timed events, script runs, reloads and the heap size of every state,
+     *   tagged with their map and instance. It can be opened in chrome://tracing, Perfetto or Speedscope once stopped.
+     *   A running trace is stopped first. States start recording on their next update.
+     *
+     *     StartChromeTrace("eluna_trace.json")
+     *     -- play for a while
+     *     StopChromeTrace()
+     *
+     * @param string path : file to write the trace to, it is overwritten
+     * @return bool started : false if the file could not be opened
+     */
+    int StartChromeTrace(Eluna* E)
+    {
+        const char* path = E->CHECKVAL<const char*>(1);
+        E->Push(sElunaChromeTrace->Start(path));
+        return 1;
+    }
+
+    /**
+     * Stops the trace started with [Global:StartChromeTrace] and completes its file.
+     *
+     * Events that states have not written yet are dropped.
+     */
+    int StopChromeTrace(Eluna* /*E*/)
+    {
+        sElunaChromeTrace->Stop();
+        return 0;
+    }
+
     /**
      * Runs a command.
      *
@@ -1226,6 +1885,8 @@ namespace LuaGlobalFunctions
     int WorldDBQuery(Eluna* E)
     {
         const char* query = E->CHECKVAL<const char*>(1);
+        if (E->metrics)
+            E->metrics->OnQuery();
 
         ElunaQuery result = WorldDatabase.QueryNamed(query);
         if (result)
@@ -1253,6 +1914,8 @@ namespace LuaGlobalFunctions
     int WorldDBExecute(Eluna* E)
     {
         const char* query = E->CHECKVAL<const char*>(1);
+        if (E->metrics)
+            E->metrics->OnQuery();
         WorldDatabase.Execute(query);
         return 0;
     }
@@ -1271,6 +1934,8 @@ namespace LuaGlobalFunctions
     int CharDBQuery(Eluna* E)
     {
         const char* query = E->CHECKVAL<const char*>(1);
+        if (E->metrics)
+            E->metrics->OnQuery();
 
         ElunaQuery result = CharacterDatabase.QueryNamed(query);
         if (result)
@@ -1298,6 +1963,8 @@ namespace LuaGlobalFunctions
     int CharDBExecute(Eluna* E)
     {
         const char* query = E->CHECKVAL<const char*>(1);
+        if (E->metrics)
+            E->metrics->OnQuery();
         CharacterDatabase.Execute(query);
         return 0;
     }
@@ -1316,6 +1983,8 @@ namespace LuaGlobalFunctions
     int AuthDBQuery(Eluna* E)
     {
         const char* query = E->CHECKVAL<const char*>(1);
+        if (E->metrics)
+            E->metrics->OnQuery();
 
         ElunaQuery result = LoginDatabase.QueryNamed(query);
         if (result)
@@ -1343,6 +2012,8 @@ namespace LuaGlobalFunctions
     int AuthDBExecute(Eluna* E)
     {
         const char* query = E->CHECKVAL<const char*>(1);
+        if (E->metrics)
+            E->metrics->OnQuery();
         LoginDatabase.Execute(query);
         return 0;
     }
@@ -1387,7 +2058,7 @@ namespace LuaGlobalFunctions
             return luaL_argerror(E->L, 2, "min is bigger than max delay");
 
         lua_pushvalue(E->L, 1);
-        int functionRef = luaL_ref(E->L, LUA_REGISTRYINDEX);
+        int functionRef = ELUNA_REF(E->L, ELUNA_REF_TIMED_EVENT);
         if (functionRef != LUA_REFNIL && functionRef != LUA_NOREF)
         {
             E->eventMgr->GetGlobalProcessor(GLOBAL_EVENTS)->AddEvent(functionRef, min, max, repeats);
@@ -1642,6 +2313,87 @@ namespace LuaGlobalFunctions
         return 1;
     }
 
+    /**
+     * Creates an empty [ElunaGossipMenu] that can be filled once and sent to players with [ElunaGossipMenu:Send].
+     *
+     * Building the menu once, for example at script load, avoids adding every item again from Lua
+     * each time the menu is shown.
+     *
+     *     local menu = CreateGossipMenu(100)
+     *     menu:AddItem(0, "Tell me about this city", 1, 1)
+     *     menu:AddItem(0, "Show me the officers' quarters", 1, 2, false, nil, 0, { minLevel = 60, team = 0 })
+     *
+     *     RegisterCreatureGossipEvent(entry, 1, function(event, player, creature)
+     *         menu:Send(player, creature)
+     *     end)
+     *
+     * @param uint32 npcText : entry ID of a header text in npc_text database table, common default is 100
+     * @param uint32 menuId = 0 : menu ID used when the sender is a [Player], see [Player:GossipSendMenu]
+     * @return [ElunaGossipMenu] menu
+     */
+    int CreateGossipMenu(Eluna* E)
+    {
+        uint32 npcText = E->CHECKVAL<uint32>(1);
+        uint32 menuId = E->CHECKVAL<uint32>(2, 0);
+
+        ElunaGossipMenu menu(npcText, menuId);
+        E->Push(&menu);
+        return 1;
+    }
+
+    /**
+     * Returns an [ElunaAuctionSnapshot], a read-only copy of the auctions indexed by item entry.
+     *
+     * The auctions are copied once, after that the snapshot can be filtered and
+     * aggregated natively without querying the auctionhouse database table.
+     *
+     *     local snapshot = GetAuctionSnapshot()
+     *     local stats = snapshot:GetStats(36908)
+     *     if stats then
+     *         print(stats.auctions, stats.minPrice, stats.medianPrice)
+     *     end
+     *
+     * @param int32 house = -1 : 0 for Alliance, 1 for Horde or 2 for neutral auction house, -1 for all of them
+     * @return [ElunaAuctionSnapshot] snapshot
+     */
+    int GetAuctionSnapshot(Eluna* E)
+    {
+        int32 house = E->CHECKVAL<int32>(1, -1);
+        if (house > 2)
+            return luaL_argerror(E->L, 1, "valid auction house expected");
+
+        ElunaAuctionSnapshot snapshot;
+        snapshot.createTime = uint32(eWorld->GetGameTime());
+        for (uint32 i = 0; i < 3; ++i)
+        {
+            if (house >= 0 && uint32(house) != i)
+                continue;
+
+            AuctionHouseObject* auctionHouse = eAuctionMgr->GetAuctionsMap(AuctionHouseType(i));
+            for (auto const& itr : auctionHouse->GetAuctions())
+            {
+                AuctionEntry const* entry = itr.second;
+
+                ElunaAuction auction;
+                auction.id = entry->Id;
+                auction.house = i;
+                auction.entry = entry->itemTemplate;
+                auction.count = entry->itemCount;
+                auction.seller = entry->owner;
+                auction.bidder = entry->bidder;
+                auction.startBid = entry->startbid;
+                auction.bid = entry->bid;
+                auction.buyout = entry->buyout;
+                auction.expireTime = uint32(entry->expireTime);
+                snapshot.Add(auction);
+            }
+        }
+
+        snapshot.BuildIndex();
+        E->Push(&snapshot);
+        return 1;
+    }
+
     /**
      * Adds an [Item] to a vendor and updates the world database.
      *
@@ -1876,6 +2628,263 @@ namespace LuaGlobalFunctions
         return addedItems;
     }
 
+    struct MailDraftSpec
+    {
+        std::string subject;
+        std::string text;
+        uint32 sender;
+        uint32 stationery;
+        uint32 delay;
+        uint32 money;
+        uint32 cod;
+        std::vector<std::pair<uint32, uint32>> items;
+        std::string error;
+    };
+
+    // Pops an optional uint32, returns false if the value is set to anything else
+    static bool PopMailDraftNumber(Eluna* E, uint32& value)
+    {
+        bool valid = lua_isnil(E->L, -1);
+        if (!valid && lua_isnumber(E->L, -1))
+        {
+            lua_Number number = lua_tonumber(E->L, -1);
+            valid = number >= 0 && number <= UINT_MAX;
+            if (valid)
+                value = static_cast<uint32>(number);
+        }
+        lua_pop(E->L, 1);
+        return valid;
+    }
+
+    // Pops an optional string, returns false if the value is set to anything else
+    static bool PopMailDraftString(Eluna* E, std::string& value)
+    {
+        bool valid = lua_isnil(E->L, -1) || lua_isstring(E->L, -1);
+        if (valid && !lua_isnil(E->L, -1))
+            value = lua_tostring(E->L, -1);
+        lua_pop(E->L, 1);
+        return valid;
+    }
+
+    // Fields of the wrong type are reported in `spec.error` like other invalid drafts, see SendMails
+    static void ReadMailDraftSpec(Eluna* E, int index, MailDraftSpec& spec)
+    {
+        spec.sender = 0;
+        spec.stationery = MAIL_STATIONERY_DEFAULT;
+        spec.delay = 0;
+        spec.money = 0;
+        spec.cod = 0;
+
+        std::pair<const char*, std::string*> const strings[] = { { "subject", &spec.subject }, { "text", &spec.text } };
+        for (auto const& field : strings)
+        {
+            lua_getfield(E->L, index, field.first);
+            if (!PopMailDraftString(E, *field.second))
+            {
+                spec.error = std::string(field.first) + " is not a string";
+                return;
+            }
+        }
+
+        std::pair<const char*, uint32*> const numbers[] = { { "sender", &spec.sender }, { "stationery", &spec.stationery }, { "delay", &spec.delay }, { "money", &spec.money }, { "cod", &spec.cod } };
+        for (auto const& field : numbers)
+        {
+            lua_getfield(E->L, index, field.first);
+            if (!PopMailDraftNumber(E, *field.second))
+            {
+                spec.error = std::string(field.first) + " is not a uint32";
+                return;
+            }
+        }
+
+        lua_getfield(E->L, index, "items");
+        if (lua_istable(E->L, -1))
+        {
+            for (int i = 1, count = lua_rawlen(E->L, -1); i <= count; ++i)
+            {
+                lua_rawgeti(E->L, -1, i);
+                uint32 entry = 0;
+                uint32 amount = 1;
+                bool valid = lua_istable(E->L, -1);
+                if (valid)
+                {
+                    lua_rawgeti(E->L, -1, 1);
+                    valid = !lua_isnil(E->L, -1);
+                    valid = PopMailDraftNumber(E, entry) && valid;
+                    lua_rawgeti(E->L, -1, 2);
+                    valid = PopMailDraftNumber(E, amount) && valid;
+                }
+                lua_pop(E->L, 1);
+
+                if (!valid)
+                {
+                    spec.error = "item " + std::to_string(i) + " is not an {entry, amount} pair";
+                    break;
+                }
+                spec.items.emplace_back(entry, amount);
+            }
+        }
+        else if (!lua_isnil(E->L, -1))
+            spec.error = "items is not a table";
+        lua_pop(E->L, 1);
+
+        if (!spec.error.empty())
+            return;
+
+        if (spec.items.size() > MAX_MAIL_ITEMS)
+        {
+            spec.error = "too many items";
+            return;
+        }
+
+        for (auto const& item : spec.items)
+        {
+            ItemTemplate const* item_proto = eObjectMgr->GetItemTemplate(item.first);
+            if (!item_proto)
+            {
+                spec.error = "item entry " + std::to_string(item.first) + " does not exist";
+                return;
+            }
+
+            if (item.second < 1 || (item_proto->MaxCount > 0 && item.second > uint32(item_proto->MaxCount)))
+            {
+                spec.error = "item entry " + std::to_string(item.first) + " has invalid amount " + std::to_string(item.second);
+                return;
+            }
+        }
+    }
+
+    /**
+     * Sends mail to many receivers at once and returns the result for each receiver.
+     *
+     * The mail is described by a draft table, either one draft shared by all receivers or a table of drafts with one for each receiver.
+     * Items are created separately for each mail.
+     *
+     * Invalid drafts do not raise an error, they are reported in the results and the other mail is still sent.
+     * Each result is a table with the fields `receiver`, `sent`, `items` and `error`.
+     * `items` holds the low GUIDs of the created items and `error` is only set when the mail was not sent.
+     *
+     * @table
+     * @columns [Field, Type, Comment]
+     * @values [subject, string, "Title (subject) of the mail"]
+     * @values [text, string, "Contents of the mail"]
+     * @values [sender, uint32, "Low GUID of the sender, 0 by default"]
+     * @values [stationery, uint32, "[MailStationery], see [Global:SendMail], MAIL_STATIONERY_DEFAULT by default"]
+     * @values [delay, uint32, "Mail send delay in milliseconds, 0 by default"]
+     * @values [money, uint32, "Money to send, 0 by default"]
+     * @values [cod, uint32, "COD money amount, 0 by default"]
+     * @values [items, table, "Table of `{entry, amount}` pairs, up to 12"]
+     *
+     *     local results = SendMails({ 1, 2, 3 }, { subject = "Season rewards", text = "Well played!", items = { { 49426, 10 } } })
+     *     for _, result in ipairs(results) do
+     *         if not result.sent then
+     *             print("Mail to", result.receiver, "failed:", result.error)
+     *         end
+     *     end
+     *
+     * @param table receivers : low GUIDs of the receivers
+     * @param table draft : a draft shared by all receivers, or a table of drafts with one for each receiver, refer to the table above
+     * @param uint32 chunkSize = 100 : not used, each mail is saved in its own database transaction by the core
+     * @return table results : a result for each receiver, in the same order as the receivers
+     */
+    int SendMails(Eluna* E)
+    {
+        luaL_checktype(E->L, 1, LUA_TTABLE);
+        luaL_checktype(E->L, 2, LUA_TTABLE);
+
+        std::vector<uint32> receivers;
+        for (int i = 1, count = lua_rawlen(E->L, 1); i <= count; ++i)
+        {
+            lua_rawgeti(E->L, 1, i);
+            receivers.push_back(E->CHECKVAL<uint32>(-1));
+            lua_pop(E->L, 1);
+        }
+
+        // A table of drafts holds a draft table for each receiver, every field of a draft is optional
+        lua_rawgeti(E->L, 2, 1);
+        bool shared = !lua_istable(E->L, -1);
+        lua_pop(E->L, 1);
+
+        std::vector<MailDraftSpec> specs(shared ? 1 : receivers.size());
+        if (shared)
+            ReadMailDraftSpec(E, 2, specs[0]);
+        else
+        {
+            if (lua_rawlen(E->L, 2) != receivers.size())
+                return luaL_argerror(E->L, 2, "one draft per receiver expected");
+
+            for (size_t i = 0; i < receivers.size(); ++i)
+            {
+                lua_rawgeti(E->L, 2, int(i + 1));
+                if (lua_istable(E->L, -1))
+                    ReadMailDraftSpec(E, lua_gettop(E->L), specs[i]);
+                else
+                    specs[i].error = "draft is not a table";
+                lua_pop(E->L, 1);
+            }
+        }
+
+        std::vector<std::vector<uint32>> itemGUIDs(receivers.size());
+
+        // The core commits each mail in its own transaction
+        for (size_t i = 0; i < receivers.size(); ++i)
+        {
+            MailDraftSpec const& spec = specs[shared ? 0 : i];
+            if (!spec.error.empty())
+                continue;
+
+            MailSender sender(MAIL_NORMAL, spec.sender, (MailStationery)spec.stationery);
+            MailDraft draft(spec.subject, spec.text);
+
+            if (spec.cod)
+                draft.SetCOD(spec.cod);
+            if (spec.money)
+                draft.SetMoney(spec.money);
+
+            for (auto const& entry : spec.items)
+            {
+                if (Item* item = Item::CreateItem(entry.first, entry.second))
+                {
+                    item->SaveToDB();
+                    draft.AddItem(item);
+                    itemGUIDs[i].push_back(item->GetGUIDLow());
+                }
+            }
+
+            ObjectGuid receiverGuid = MAKE_NEW_GUID(receivers[i], 0, HIGHGUID_PLAYER);
+            Player* receiverPlayer = eObjectAccessor()FindPlayer(receiverGuid);
+            draft.SendMailTo(MailReceiver(receiverPlayer, receiverGuid), sender);
+        }
+
+        lua_createtable(E->L, int(receivers.size()), 0);
+        for (size_t i = 0; i < receivers.size(); ++i)
+        {
+            MailDraftSpec const& spec = specs[shared ? 0 : i];
+
+            lua_createtable(E->L, 0, 4);
+            E->Push(receivers[i]);
+            lua_setfield(E->L, -2, "receiver");
+            E->Push(spec.error.empty());
+            lua_setfield(E->L, -2, "sent");
+            if (!spec.error.empty())
+            {
+                E->Push(spec.error);
+                lua_setfield(E->L, -2, "error");
+            }
+
+            lua_createtable(E->L, int(itemGUIDs[i].size()), 0);
+            for (size_t j = 0; j < itemGUIDs[i].size(); ++j)
+            {
+                E->Push(itemGUIDs[i][j]);
+                lua_rawseti(E->L, -2, int(j + 1));
+            }
+            lua_setfield(E->L, -2, "items");
+
+            lua_rawseti(E->L, -2, int(i + 1));
+        }
+        return 1;
+    }
+
     /**
      * Performs a bitwise AND (a & b).
      *
@@ -2920,6 +3929,8 @@ namespace LuaGlobalFunctions
         { "RegisterBGEvent", &LuaGlobalFunctions::RegisterBGEvent },
         { "RegisterMapEvent", &LuaGlobalFunctions::RegisterMapEvent },
         { "RegisterInstanceEvent", &LuaGlobalFunctions::RegisterInstanceEvent },
+        { "RegisterCommand", &LuaGlobalFunctions::RegisterCommand, METHOD_REG_WORLD }, // World state method only in multistate
+        { "RegisterChatFilter", &LuaGlobalFunctions::RegisterChatFilter, METHOD_REG_WORLD }, // World state method only in multistate
 
         { "ClearBattleGroundEvents", &LuaGlobalFunctions::ClearBattleGroundEvents },
         { "ClearCreatureEvents", &LuaGlobalFunctions::ClearCreatureEvents },
@@ -2968,6 +3979,12 @@ namespace LuaGlobalFunctions
         { "bit_or", &LuaGlobalFunctions::bit_or },
         { "bit_and", &LuaGlobalFunctions::bit_and },
         { "GetItemLink", &LuaGlobalFunctions::GetItemLink },
+        { "GetItemName", &LuaGlobalFunctions::GetItemName },
+        { "GetSpellLink", &LuaGlobalFunctions::GetSpellLink },
+        { "GetQuestLink", &LuaGlobalFunctions::GetQuestLink },
+        { "GetCreatureName", &LuaGlobalFunctions::GetCreatureName },
+        { "FormatLinks", &LuaGlobalFunctions::FormatLinks },
+        { "ClearStringCache", &LuaGlobalFunctions::ClearStringCache },
         { "GetMapById", &LuaGlobalFunctions::GetMapById },
         { "GetCurrTime", &LuaGlobalFunctions::GetCurrTime },
         { "GetTimeDiff", &LuaGlobalFunctions::GetTimeDiff },
@@ -2985,6 +4002,15 @@ namespace LuaGlobalFunctions
 
         // Other
         { "ReloadEluna", &LuaGlobalFunctions::ReloadEluna },
+        { "RunBenchmarks", &LuaGlobalFunctions::RunBenchmarks },
+        { "StartHookTrace", &LuaGlobalFunctions::StartHookTrace },
+        { "StopHookTrace", &LuaGlobalFunctions::StopHookTrace },
+        { "GetScriptProfile", &LuaGlobalFunctions::GetScriptProfile },
+        { "ResetScriptProfile", &LuaGlobalFunctions::ResetScriptProfile },
+        { "GetHeapCensus", &LuaGlobalFunctions::GetHeapCensus },
+        { "GetRegistryRefCounts", &LuaGlobalFunctions::GetRegistryRefCounts },
+        { "StartChromeTrace", &LuaGlobalFunctions::StartChromeTrace },
+        { "StopChromeTrace", &LuaGlobalFunctions::StopChromeTrace },
         { "RunCommand", &LuaGlobalFunctions::RunCommand },
         { "SendWorldMessage", &LuaGlobalFunctions::SendWorldMessage },
         { "WorldDBQuery", &LuaGlobalFunctions::WorldDBQuery, METHOD_REG_ALL, METHOD_FLAG_UNSAFE },
@@ -2998,6 +4024,8 @@ namespace LuaGlobalFunctions
         { "RemoveEvents", &LuaGlobalFunctions::RemoveEvents },
         { "PerformIngameSpawn", &LuaGlobalFunctions::PerformIngameSpawn },
         { "CreatePacket", &LuaGlobalFunctions::CreatePacket },
+        { "CreateGossipMenu", &LuaGlobalFunctions::CreateGossipMenu },
+        { "GetAuctionSnapshot", &LuaGlobalFunctions::GetAuctionSnapshot, METHOD_REG_WORLD },
         { "AddVendorItem", &LuaGlobalFunctions::AddVendorItem },
         { "VendorRemoveItem", &LuaGlobalFunctions::VendorRemoveItem },
         { "VendorRemoveAllItems", &LuaGlobalFunctions::VendorRemoveAllItems },
@@ -3005,6 +4033,7 @@ namespace LuaGlobalFunctions
         { "Ban", &LuaGlobalFunctions::Ban },
         { "SaveAllPlayers", &LuaGlobalFunctions::SaveAllPlayers },
         { "SendMail", &LuaGlobalFunctions::SendMail },
+        { "SendMails", &LuaGlobalFunctions::SendMails },
         { "AddTaxiPath", &LuaGlobalFunctions::AddTaxiPath },
         { "CreateInt64", &LuaGlobalFunctions::CreateLongLong },
         { "CreateUint64", &LuaGlobalFunctions::CreateULongLong },
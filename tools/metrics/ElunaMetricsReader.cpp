@@ -0,0 +1,165 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "ElunaMetricsReader.h"
+
+#if defined _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace ElunaMetricsLayout;
+
+ElunaMetricsReader::ElunaMetricsReader() : base(nullptr), size(0)
+{
+}
+
+ElunaMetricsReader::~ElunaMetricsReader()
+{
+    Close();
+}
+
+bool ElunaMetricsReader::Open(std::string const& path)
+{
+    Close();
+
+#if defined _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        error = "could not open " + path;
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < LONGLONG(sizeof(Header)))
+    {
+        CloseHandle(file);
+        error = path + " is not a metrics file";
+        return false;
+    }
+    size = size_t(fileSize.QuadPart);
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+    {
+        error = "could not map " + path;
+        return false;
+    }
+
+    base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+    CloseHandle(mapping);
+    if (!base)
+    {
+        error = "could not map " + path;
+        return false;
+    }
+#else
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        error = "could not open " + path;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(file, &info) != 0 || size_t(info.st_size) < sizeof(Header))
+    {
+        close(file);
+        error = path + " is not a metrics file";
+        return false;
+    }
+    size = size_t(info.st_size);
+
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+    close(file);
+    if (mapping == MAP_FAILED)
+    {
+        error = "could not map " + path;
+        return false;
+    }
+    base = mapping;
+#endif
+
+    return true;
+}
+
+void ElunaMetricsReader::Close()
+{
+    if (!base)
+        return;
+
+#if defined _WIN32
+    UnmapViewOfFile(base);
+#else
+    munmap(const_cast<void*>(base), size);
+#endif
+    base = nullptr;
+    size = 0;
+}
+
+ElunaMetricsLayout::Header const* ElunaMetricsReader::GetHeader() const
+{
+    Header const* header = static_cast<Header const*>(base);
+    if (!header || header->magic.load(std::memory_order_acquire) != MAGIC)
+        return nullptr;
+    return header;
+}
+
+uint32_t ElunaMetricsReader::GetProcessId() const
+{
+    Header const* header = GetHeader();
+    return header ? header->processId : 0;
+}
+
+uint64_t ElunaMetricsReader::GetStartTime() const
+{
+    Header const* header = GetHeader();
+    return header ? header->startTime : 0;
+}
+
+bool ElunaMetricsReader::Read(std::vector<State>& states)
+{
+    states.clear();
+
+    Header const* header = GetHeader();
+    if (!header)
+    {
+        error = "the server has not written the file yet";
+        return false;
+    }
+
+    if (header->version != VERSION || header->slotSize != sizeof(Slot) || header->metricCount != METRIC_COUNT)
+    {
+        error = "the file was written by a different version of Eluna";
+        return false;
+    }
+
+    if (GetFileSize(header->slotCount) > size)
+    {
+        error = "the file is smaller than its header says";
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header->slotCount; ++i)
+    {
+        State state;
+        uint32_t used;
+        if (!ElunaMetricsLayout::Read(*GetSlot(base, i), used, state.values) || !used)
+            continue;
+
+        state.slot = i;
+        state.mapId = int32_t(int64_t(state.values[METRIC_MAP_ID]));
+        state.instanceId = uint32_t(state.values[METRIC_INSTANCE_ID]);
+        states.push_back(state);
+    }
+    return true;
+}
@@ -0,0 +1,64 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _ELUNA_METRICS_READER_H
+#define _ELUNA_METRICS_READER_H
+
+#include "ElunaMetricsLayout.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * Reads the metrics file written by a server with Eluna.MetricsFile set.
+ *
+ * The file is mapped read only and never locked, reading it has no effect on the server.
+ *   It can be opened before the server mapped it, Read fails until the server did.
+ */
+class ElunaMetricsReader
+{
+public:
+    struct State
+    {
+        uint32_t slot;
+        int32_t mapId;
+        uint32_t instanceId;
+        uint64_t values[ElunaMetricsLayout::METRIC_COUNT];
+    };
+
+    ElunaMetricsReader();
+    ~ElunaMetricsReader();
+
+    ElunaMetricsReader(ElunaMetricsReader const&) = delete;
+    ElunaMetricsReader& operator=(ElunaMetricsReader const&) = delete;
+
+    /*
+     * Maps the file, returns false and sets the error if it can not be read.
+     */
+    bool Open(std::string const& path);
+    void Close();
+
+    uint32_t GetProcessId() const;
+    uint64_t GetStartTime() const;
+
+    /*
+     * Replaces `states` with a snapshot of every state the server publishes. Slots that were written
+     *   for all read attempts are left out. Returns false and sets the error if the file is not valid.
+     */
+    bool Read(std::vector<State>& states);
+
+    std::string const& GetError() const { return error; }
+
+private:
+    ElunaMetricsLayout::Header const* GetHeader() const;
+
+    void const* base;
+    size_t size;
+    std::string error;
+};
+
+#endif
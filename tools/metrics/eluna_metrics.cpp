@@ -0,0 +1,156 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+/*
+ * Prints the metrics a server publishes with Eluna.MetricsFile.
+ *
+ *     eluna-metrics <file> [--watch <seconds>] [--raw]
+ *
+ * By default a table of all states is printed once. --watch prints it again every interval,
+ *   with the hooks, calls and errors per second since the previous print. --raw prints one
+ *   `slot name=value ...` line per state instead, for other tools to collect.
+ */
+
+#include "ElunaMetricsReader.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <thread>
+
+using namespace ElunaMetricsLayout;
+
+namespace
+{
+    int Usage()
+    {
+        fprintf(stderr, "usage: eluna-metrics <file> [--watch <seconds>] [--raw]\n");
+        return 2;
+    }
+
+    uint64_t NowMs()
+    {
+        return uint64_t(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+    void PrintRaw(std::vector<ElunaMetricsReader::State> const& states)
+    {
+        for (ElunaMetricsReader::State const& state : states)
+        {
+            printf("%u", state.slot);
+            for (uint32_t i = 0; i < METRIC_COUNT; ++i)
+            {
+                if (i == METRIC_MAP_ID)
+                    printf(" %s=%d", GetMetricName(i), state.mapId);
+                else
+                    printf(" %s=%llu", GetMetricName(i), static_cast<unsigned long long>(state.values[i]));
+            }
+            printf("\n");
+        }
+        fflush(stdout);
+    }
+
+    // Per second since `previous`, 0 for states that were not printed before
+    double Rate(ElunaMetricsReader::State const& state, ElunaMetricsReader::State const* previous, Metric metric)
+    {
+        if (!previous)
+            return 0.0;
+
+        uint64_t elapsed = state.values[METRIC_PUBLISH_TIME] - previous->values[METRIC_PUBLISH_TIME];
+        if (!elapsed || state.values[metric] < previous->values[metric])
+            return 0.0;
+        return double(state.values[metric] - previous->values[metric]) * 1000.0 / double(elapsed);
+    }
+
+    void PrintTable(std::vector<ElunaMetricsReader::State> const& states, std::map<uint32_t, ElunaMetricsReader::State> const& previous, bool rates)
+    {
+        uint64_t now = NowMs();
+        printf("%6s %8s %12s %9s %9s %12s %8s %8s %8s %10s %6s %8s %8s %6s\n", "map", "instance", rates ? "hooks/s" : "hooks",
+            "avg us", "max us", rates ? "calls/s" : "calls", rates ? "errors/s" : "errors", "timed", "pending", "heap KB", "gc", "gc ms", "queries", "age s");
+
+        for (ElunaMetricsReader::State const& state : states)
+        {
+            // A slot reused by another state is not compared with its previous owner
+            ElunaMetricsReader::State const* last = nullptr;
+            auto itr = previous.find(state.slot);
+            if (rates && itr != previous.end() && itr->second.mapId == state.mapId && itr->second.instanceId == state.instanceId)
+                last = &itr->second;
+
+            auto count = [&](Metric metric) { return rates ? Rate(state, last, metric) : double(state.values[metric]); };
+
+            uint64_t hooks = state.values[METRIC_HOOKS];
+            uint64_t published = state.values[METRIC_PUBLISH_TIME];
+            int precision = rates ? 1 : 0;
+            printf("%6d %8u %12.*f %9llu %9llu %12.*f %8.*f %8llu %8llu %10llu %6llu %8llu %8llu %6lld\n",
+                state.mapId, state.instanceId, precision, count(METRIC_HOOKS),
+                static_cast<unsigned long long>(hooks ? state.values[METRIC_HOOK_TIME] / hooks : 0),
+                static_cast<unsigned long long>(state.values[METRIC_HOOK_MAX_TIME]),
+                precision, count(METRIC_CALLS), precision, count(METRIC_ERRORS),
+                static_cast<unsigned long long>(state.values[METRIC_TIMED_EVENTS]),
+                static_cast<unsigned long long>(state.values[METRIC_PENDING_TIMED_EVENTS]),
+                static_cast<unsigned long long>(state.values[METRIC_HEAP_BYTES] / 1024),
+                static_cast<unsigned long long>(state.values[METRIC_GC_COLLECTIONS]),
+                static_cast<unsigned long long>(state.values[METRIC_GC_TIME] / 1000),
+                static_cast<unsigned long long>(state.values[METRIC_QUERIES]),
+                published ? static_cast<long long>((now - published) / 1000) : -1LL);
+        }
+        printf("\n");
+        fflush(stdout);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+        return Usage();
+
+    std::string path = argv[1];
+    unsigned watch = 0;
+    bool raw = false;
+    for (int i = 2; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--watch") && i + 1 < argc)
+            watch = unsigned(atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--raw"))
+            raw = true;
+        else
+            return Usage();
+    }
+
+    ElunaMetricsReader reader;
+    if (!reader.Open(path))
+    {
+        fprintf(stderr, "eluna-metrics: %s\n", reader.GetError().c_str());
+        return 1;
+    }
+
+    std::vector<ElunaMetricsReader::State> states;
+    std::map<uint32_t, ElunaMetricsReader::State> previous;
+    for (;;)
+    {
+        if (!reader.Read(states))
+        {
+            fprintf(stderr, "eluna-metrics: %s\n", reader.GetError().c_str());
+            return 1;
+        }
+
+        if (raw)
+            PrintRaw(states);
+        else
+            PrintTable(states, previous, watch != 0);
+
+        if (!watch)
+            return 0;
+
+        previous.clear();
+        for (ElunaMetricsReader::State const& state : states)
+            previous[state.slot] = state;
+
+        std::this_thread::sleep_for(std::chrono::seconds(watch));
+    }
+}
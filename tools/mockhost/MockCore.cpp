@@ -0,0 +1,228 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#include "MockCore.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+    void Print(FILE* out, char const* format, va_list args)
+    {
+        vfprintf(out, format, args);
+        fputc('\n', out);
+    }
+}
+
+std::string ObjectGuid::GetString() const
+{
+    char buff[64];
+    snprintf(buff, sizeof(buff), "guid 0x%016llX", static_cast<unsigned long long>(m_guid));
+    return buff;
+}
+
+Log& Log::Instance()
+{
+    static Log instance;
+    return instance;
+}
+
+void Log::outString(char const* format, ...)
+{
+    if (quiet)
+        return;
+
+    va_list args;
+    va_start(args, format);
+    Print(stdout, format, args);
+    va_end(args);
+}
+
+void Log::outError(char const* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    Print(stderr, format, args);
+    va_end(args);
+}
+
+void Log::outErrorEluna(char const* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    Print(stderr, format, args);
+    va_end(args);
+}
+
+void Log::outDebug(char const* format, ...)
+{
+    if (!debug)
+        return;
+
+    va_list args;
+    va_start(args, format);
+    Print(stdout, format, args);
+    va_end(args);
+}
+
+Config& Config::Instance()
+{
+    static Config instance;
+    return instance;
+}
+
+bool Config::GetBoolDefault(char const* name, bool def) const
+{
+    auto itr = values.find(name);
+    if (itr == values.end())
+        return def;
+
+    std::string const& value = itr->second;
+    return value == "1" || value == "true" || value == "yes";
+}
+
+std::string Config::GetStringDefault(char const* name, char const* def) const
+{
+    auto itr = values.find(name);
+    return itr != values.end() ? itr->second : def;
+}
+
+int32 Config::GetIntDefault(char const* name, int32 def) const
+{
+    auto itr = values.find(name);
+    return itr != values.end() ? int32(strtol(itr->second.c_str(), nullptr, 10)) : def;
+}
+
+float Config::GetFloatDefault(char const* name, float def) const
+{
+    auto itr = values.find(name);
+    return itr != values.end() ? strtof(itr->second.c_str(), nullptr) : def;
+}
+
+uint32 getMSTime()
+{
+    static std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+    return uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+uint32 urand(uint32 min, uint32 max)
+{
+    static std::mt19937 generator;
+    return std::uniform_int_distribution<uint32>(min, max)(generator);
+}
+
+DBCStorage<FactionTemplateEntry> const sFactionTemplateStore({ { 14, { 14, 1 } } });
+
+uint32 Object::GetUInt32Value(uint16 index) const
+{
+    auto itr = fields.find(index);
+    return itr != fields.end() ? itr->second : 0;
+}
+
+uint32 WorldObject::GetMapId() const
+{
+    return map ? map->GetId() : 0;
+}
+
+uint32 WorldObject::GetInstanceId() const
+{
+    return map ? map->GetInstanceId() : 0;
+}
+
+Eluna* WorldObject::GetEluna() const
+{
+    if (map && map->GetEluna())
+        return map->GetEluna();
+    return sWorld.GetEluna();
+}
+
+float WorldObject::GetDistance(WorldObject const* obj) const
+{
+    float dx = x - obj->GetPositionX();
+    float dy = y - obj->GetPositionY();
+    float dz = z - obj->GetPositionZ();
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+ObjectAccessor& ObjectAccessor::Instance()
+{
+    static ObjectAccessor instance;
+    return instance;
+}
+
+Player* ObjectAccessor::FindPlayer(ObjectGuid guid) const
+{
+    auto itr = players.find(guid);
+    return itr != players.end() ? itr->second : nullptr;
+}
+
+Player* ObjectAccessor::FindPlayerByLowGUID(uint32 lowGuid) const
+{
+    return FindPlayer(ObjectGuid(HIGHGUID_PLAYER, lowGuid));
+}
+
+void ObjectAccessor::AddPlayer(Player* player)
+{
+    players[player->GetObjectGuid()] = player;
+}
+
+void ObjectAccessor::RemovePlayer(Player* player)
+{
+    players.erase(player->GetObjectGuid());
+}
+
+AuctionHouseMgr& AuctionHouseMgr::Instance()
+{
+    static AuctionHouseMgr instance;
+    return instance;
+}
+
+ObjectMgr& ObjectMgr::Instance()
+{
+    static ObjectMgr instance;
+    return instance;
+}
+
+CreatureInfo const* ObjectMgr::GetCreatureTemplate(uint32 entry)
+{
+    return &creatures.emplace(entry, CreatureInfo{ entry }).first->second;
+}
+
+GameObjectInfo const* ObjectMgr::GetGameObjectInfo(uint32 entry)
+{
+    return &gameObjects.emplace(entry, GameObjectInfo{ entry }).first->second;
+}
+
+ItemPrototype const* ObjectMgr::GetItemPrototype(uint32 entry)
+{
+    return &items.emplace(entry, ItemPrototype{ entry }).first->second;
+}
+
+World& World::Instance()
+{
+    static World instance;
+    return instance;
+}
+
+MapManager& MapManager::Instance()
+{
+    static MapManager instance;
+    return instance;
+}
+
+void MapManager::DoForAllMaps(std::function<void(Map*)> const& worker)
+{
+    for (Map& map : maps)
+        worker(&map);
+}
+
+Map* MapManager::CreateMap(uint32 id, uint32 instanceId)
+{
+    maps.emplace_back(id, instanceId);
+    return &maps.back();
+}
@@ -0,0 +1,708 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+#ifndef _MOCK_CORE_H
+#define _MOCK_CORE_H
+
+/*
+ * A minimal stand-in for the MaNGOS classic interfaces Eluna uses, so the engine can be built
+ *   and run without a core. Every core header Eluna includes is generated as an include of this file.
+ *
+ * Objects are plain data: they have a guid, an entry, a name, a position and a map, and do nothing
+ *   on their own. Only what the engine itself calls is declared, the core's method tables are not built.
+ */
+
+#include <cassert>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+typedef int64_t int64;
+typedef int32_t int32;
+typedef int16_t int16;
+typedef int8_t int8;
+typedef uint64_t uint64;
+typedef uint32_t uint32;
+typedef uint16_t uint16;
+typedef uint8_t uint8;
+
+#define PLATFORM_WINDOWS 0
+#define PLATFORM_UNIX 1
+#define PLATFORM PLATFORM_UNIX
+
+#define MANGOS_ASSERT(x) assert(x)
+
+#define PROJECT_REVISION_NR "mockhost"
+
+class Eluna;
+class Map;
+class Player;
+class Creature;
+class GameObject;
+class Corpse;
+class Unit;
+class WorldSession;
+class Quest;
+class Spell;
+class Group;
+class Guild;
+class Channel;
+class Item;
+class Pet;
+class Weather;
+class SpellCastTargets;
+class AuctionHouseObject;
+class BattleGround;
+class Aura;
+class AuraEffect;
+class DispelInfo;
+class ProcEventInfo;
+class DamageInfo;
+class HealInfo;
+class SpellDestination;
+class QueryNamedResult;
+class TemporarySummon;
+struct SpellEntry;
+struct ItemPrototype;
+struct AuctionEntry;
+struct AreaTriggerEntry;
+struct CreatureInfo;
+struct GameObjectInfo;
+
+enum TypeID
+{
+    TYPEID_OBJECT = 0,
+    TYPEID_ITEM = 1,
+    TYPEID_CONTAINER = 2,
+    TYPEID_UNIT = 3,
+    TYPEID_PLAYER = 4,
+    TYPEID_GAMEOBJECT = 5,
+    TYPEID_DYNAMICOBJECT = 6,
+    TYPEID_CORPSE = 7
+};
+
+enum TypeMask
+{
+    TYPEMASK_OBJECT = 0x0001,
+    TYPEMASK_ITEM = 0x0002,
+    TYPEMASK_CONTAINER = 0x0004,
+    TYPEMASK_UNIT = 0x0008,
+    TYPEMASK_PLAYER = 0x0010,
+    TYPEMASK_GAMEOBJECT = 0x0020,
+    TYPEMASK_DYNAMICOBJECT = 0x0040,
+    TYPEMASK_CORPSE = 0x0080,
+    TYPEMASK_WORLDOBJECT = TYPEMASK_UNIT | TYPEMASK_PLAYER | TYPEMASK_GAMEOBJECT | TYPEMASK_DYNAMICOBJECT | TYPEMASK_CORPSE
+};
+
+enum HighGuid
+{
+    HIGHGUID_ITEM = 0x4000,
+    HIGHGUID_CONTAINER = 0x4000,
+    HIGHGUID_PLAYER = 0x0000,
+    HIGHGUID_GAMEOBJECT = 0xF110,
+    HIGHGUID_TRANSPORT = 0xF120,
+    HIGHGUID_UNIT = 0xF130,
+    HIGHGUID_PET = 0xF140,
+    HIGHGUID_DYNAMICOBJECT = 0xF100,
+    HIGHGUID_CORPSE = 0xF101,
+    HIGHGUID_MO_TRANSPORT = 0x1FC0
+};
+
+enum SpellSchoolMask : uint32
+{
+    SPELL_SCHOOL_MASK_NONE = 0x00,
+    SPELL_SCHOOL_MASK_NORMAL = 0x01
+};
+
+enum DamageEffectType : uint8
+{
+    DIRECT_DAMAGE = 0,
+    SPELL_DIRECT_DAMAGE = 1,
+    DOT = 2,
+    HEAL = 3,
+    NODAMAGE = 4,
+    SELF_DAMAGE = 5
+};
+
+enum WeaponAttackType : uint8
+{
+    BASE_ATTACK = 0,
+    OFF_ATTACK = 1,
+    RANGED_ATTACK = 2
+};
+
+enum SpellEffectIndex
+{
+    EFFECT_INDEX_0 = 0,
+    EFFECT_INDEX_1 = 1,
+    EFFECT_INDEX_2 = 2
+};
+
+enum InventoryResult
+{
+    EQUIP_ERR_OK = 0
+};
+
+enum WeatherState
+{
+    WEATHER_STATE_FINE = 0
+};
+
+enum ShutdownExitCode
+{
+    SHUTDOWN_EXIT_CODE = 0
+};
+
+enum ShutdownMask
+{
+    SHUTDOWN_MASK_RESTART = 1
+};
+
+enum DuelCompleteType
+{
+    DUEL_INTERRUPTED = 0,
+    DUEL_WON = 1,
+    DUEL_FLED = 2
+};
+
+enum GroupType
+{
+    GROUPTYPE_NORMAL = 0
+};
+
+enum BattleGroundTypeId
+{
+    BATTLEGROUND_TYPE_NONE = 0
+};
+
+enum Team
+{
+    TEAM_NONE = 0,
+    HORDE = 67,
+    ALLIANCE = 469
+};
+
+enum AccountTypes
+{
+    SEC_PLAYER = 0,
+    SEC_MODERATOR = 1,
+    SEC_GAMEMASTER = 2,
+    SEC_ADMINISTRATOR = 3,
+    SEC_CONSOLE = 4
+};
+
+enum UnitFields
+{
+    UNIT_FIELD_FLAGS = 0x2E
+};
+
+enum UnitFlags
+{
+    UNIT_FLAG_PASSIVE = 0x00000200
+};
+
+class ObjectGuid
+{
+public:
+    ObjectGuid() : m_guid(0) { }
+    explicit ObjectGuid(uint64 guid) : m_guid(guid) { }
+    ObjectGuid(HighGuid hi, uint32 entry, uint32 counter) :
+        m_guid(counter ? uint64(counter) | (uint64(entry) << 24) | (uint64(hi) << 48) : 0) { }
+    ObjectGuid(HighGuid hi, uint32 counter) : m_guid(counter ? uint64(counter) | (uint64(hi) << 48) : 0) { }
+
+    uint64 GetRawValue() const { return m_guid; }
+    HighGuid GetHigh() const { return HighGuid((m_guid >> 48) & 0xFFFF); }
+    uint32 GetEntry() const { return HasEntry() ? uint32((m_guid >> 24) & 0xFFFFFF) : 0; }
+    uint32 GetCounter() const { return HasEntry() ? uint32(m_guid & 0xFFFFFF) : uint32(m_guid & 0xFFFFFFFF); }
+
+    bool IsEmpty() const { return m_guid == 0; }
+    bool IsPlayer() const { return !IsEmpty() && GetHigh() == HIGHGUID_PLAYER; }
+    bool IsCreature() const { return GetHigh() == HIGHGUID_UNIT; }
+    bool IsGameObject() const { return GetHigh() == HIGHGUID_GAMEOBJECT; }
+    bool IsCorpse() const { return GetHigh() == HIGHGUID_CORPSE; }
+    bool IsItem() const { return GetHigh() == HIGHGUID_ITEM; }
+
+    bool operator==(ObjectGuid const& guid) const { return m_guid == guid.m_guid; }
+    bool operator!=(ObjectGuid const& guid) const { return m_guid != guid.m_guid; }
+    bool operator<(ObjectGuid const& guid) const { return m_guid < guid.m_guid; }
+
+    std::string GetString() const;
+
+private:
+    bool HasEntry() const
+    {
+        HighGuid high = GetHigh();
+        return high == HIGHGUID_UNIT || high == HIGHGUID_PET || high == HIGHGUID_GAMEOBJECT || high == HIGHGUID_TRANSPORT || high == HIGHGUID_DYNAMICOBJECT;
+    }
+
+    uint64 m_guid;
+};
+
+namespace std
+{
+    template<>
+    struct hash<ObjectGuid>
+    {
+        size_t operator()(ObjectGuid const& guid) const { return hash<uint64>()(guid.GetRawValue()); }
+    };
+}
+
+class Log
+{
+public:
+    static Log& Instance();
+
+    void outString(char const* format, ...);
+    void outError(char const* format, ...);
+    void outErrorEluna(char const* format, ...);
+    void outDebug(char const* format, ...);
+
+    bool quiet = false;     // --quiet, only errors are printed
+    bool debug = false;     // --debug
+};
+
+#define sLog Log::Instance()
+
+class Config
+{
+public:
+    static Config& Instance();
+
+    // Key=Value pairs given on the command line, see eluna_mockhost.cpp
+    void Set(std::string const& name, std::string const& value) { values[name] = value; }
+
+    bool GetBoolDefault(char const* name, bool def) const;
+    std::string GetStringDefault(char const* name, char const* def) const;
+    int32 GetIntDefault(char const* name, int32 def) const;
+    float GetFloatDefault(char const* name, float def) const;
+
+private:
+    std::map<std::string, std::string> values;
+};
+
+#define sConfig Config::Instance()
+
+#define MAKE_NEW_GUID(l, e, h) ObjectGuid(HighGuid(h), uint32(e), uint32(l))
+
+uint32 getMSTime();
+uint32 urand(uint32 min, uint32 max);
+inline uint32 getMSTimeDiff(uint32 oldMSTime, uint32 newMSTime) { return newMSTime - oldMSTime; }
+inline uint32 GetMSTimeDiffToNow(uint32 oldMSTime) { return getMSTimeDiff(oldMSTime, getMSTime()); }
+
+struct FactionTemplateEntry
+{
+    uint32 ID;
+    uint32 hostileMask;
+
+    bool IsHostileTo(FactionTemplateEntry const& entry) const { return (hostileMask & entry.hostileMask) != 0; }
+};
+
+template<typename T>
+class DBCStorage
+{
+public:
+    explicit DBCStorage(std::map<uint32, T> entries) : entries(std::move(entries)) { }
+
+    T const* LookupEntry(uint32 id) const
+    {
+        auto itr = entries.find(id);
+        return itr != entries.end() ? &itr->second : nullptr;
+    }
+
+private:
+    std::map<uint32, T> entries;
+};
+
+// Only the monster faction used by the range checks
+extern DBCStorage<FactionTemplateEntry> const sFactionTemplateStore;
+
+class Object
+{
+public:
+    virtual ~Object() { }
+
+    ObjectGuid const& GetObjectGuid() const { return guid; }
+    ObjectGuid const& GetGUID() const { return guid; }
+    uint32 GetGUIDLow() const { return guid.GetCounter(); }
+    uint32 GetEntry() const { return entry; }
+    void SetEntry(uint32 value) { entry = value; }
+    uint8 GetTypeId() const { return typeId; }
+    bool isType(TypeMask mask) const { return (mask & (1 << typeId)) != 0 || (mask & TYPEMASK_OBJECT) != 0; }
+    bool IsInWorld() const { return true; }
+
+    uint32 GetUInt32Value(uint16 index) const;
+    void SetUInt32Value(uint16 index, uint32 value) { fields[index] = value; }
+    bool HasFlag(uint16 index, uint32 flag) const { return (GetUInt32Value(index) & flag) != 0; }
+
+    // Defined once the object types are complete
+    Unit* ToUnit();
+    Unit const* ToUnit() const;
+    Player* ToPlayer();
+    Player const* ToPlayer() const;
+    Creature* ToCreature();
+    Creature const* ToCreature() const;
+    GameObject* ToGameObject();
+    GameObject const* ToGameObject() const;
+    Corpse* ToCorpse();
+    Corpse const* ToCorpse() const;
+
+protected:
+    Object(TypeID typeId, ObjectGuid guid, uint32 entry) : guid(guid), entry(entry), typeId(typeId) { }
+
+private:
+    ObjectGuid guid;
+    uint32 entry;
+    uint8 typeId;
+    std::map<uint16, uint32> fields;
+};
+
+class WorldObject : public Object
+{
+public:
+    Map* GetMap() const { return map; }
+    void SetMap(Map* value) { map = value; }
+    uint32 GetMapId() const;
+    uint32 GetInstanceId() const;
+    Eluna* GetEluna() const;
+
+    std::string const& GetName() const { return name; }
+    void SetName(std::string const& value) { name = value; }
+
+    float GetPositionX() const { return x; }
+    float GetPositionY() const { return y; }
+    float GetPositionZ() const { return z; }
+    float GetOrientation() const { return o; }
+    void Relocate(float px, float py, float pz, float po = 0.0f) { x = px; y = py; z = pz; o = po; }
+
+    float GetDistance(WorldObject const* obj) const;
+    bool IsWithinDistInMap(WorldObject const* obj, float dist) const { return obj->GetMap() == map && GetDistance(obj) <= dist; }
+    bool GetDistanceOrder(WorldObject const* obj1, WorldObject const* obj2) const { return GetDistance(obj1) < GetDistance(obj2); }
+
+    uint32 GetZoneId() const { return 0; }
+    uint32 GetAreaId() const { return 0; }
+
+protected:
+    WorldObject(TypeID typeId, ObjectGuid guid, uint32 entry) : Object(typeId, guid, entry), map(nullptr), x(0.0f), y(0.0f), z(0.0f), o(0.0f) { }
+
+private:
+    Map* map;
+    std::string name;
+    float x, y, z, o;
+};
+
+class Unit : public WorldObject
+{
+public:
+    uint32 GetHealth() const { return health; }
+    uint32 GetMaxHealth() const { return maxHealth; }
+    void SetHealth(uint32 value) { health = value; }
+    void SetMaxHealth(uint32 value) { maxHealth = value; }
+    uint32 GetLevel() const { return level; }
+    uint32 getLevel() const { return level; }
+    void SetLevel(uint32 value) { level = value; }
+    bool IsAlive() const { return health > 0; }
+
+    FactionTemplateEntry const* getFactionTemplateEntry() const { return sFactionTemplateStore.LookupEntry(14); }
+    bool IsHostileTo(Unit const* unit) const { return unit->GetTypeId() != GetTypeId(); }
+
+protected:
+    Unit(TypeID typeId, ObjectGuid guid, uint32 entry) : WorldObject(typeId, guid, entry), health(1), maxHealth(1), level(1) { }
+
+private:
+    uint32 health;
+    uint32 maxHealth;
+    uint32 level;
+};
+
+class Player : public Unit
+{
+public:
+    explicit Player(ObjectGuid guid) : Unit(TYPEID_PLAYER, guid, 0) { }
+    explicit Player(uint32 lowGuid) : Player(ObjectGuid(HIGHGUID_PLAYER, lowGuid)) { }
+
+    WorldSession* GetSession() const { return nullptr; }
+};
+
+class Creature : public Unit
+{
+public:
+    explicit Creature(ObjectGuid guid) : Unit(TYPEID_UNIT, guid, guid.GetEntry()) { }
+    Creature(uint32 entry, uint32 lowGuid) : Creature(ObjectGuid(HIGHGUID_UNIT, entry, lowGuid)) { }
+};
+
+class TemporarySummon : public Creature
+{
+public:
+    using Creature::Creature;
+};
+
+class Pet : public Creature
+{
+public:
+    using Creature::Creature;
+};
+
+class GameObject : public WorldObject
+{
+public:
+    explicit GameObject(ObjectGuid guid) : WorldObject(TYPEID_GAMEOBJECT, guid, guid.GetEntry()) { }
+    GameObject(uint32 entry, uint32 lowGuid) : GameObject(ObjectGuid(HIGHGUID_GAMEOBJECT, entry, lowGuid)) { }
+
+    Unit* GetOwner() const { return nullptr; }
+};
+
+class Corpse : public WorldObject
+{
+public:
+    explicit Corpse(ObjectGuid guid) : WorldObject(TYPEID_CORPSE, guid, 0) { }
+    explicit Corpse(uint32 lowGuid) : Corpse(ObjectGuid(HIGHGUID_CORPSE, lowGuid)) { }
+};
+
+inline Unit* Object::ToUnit() { return typeId == TYPEID_UNIT || typeId == TYPEID_PLAYER ? static_cast<Unit*>(this) : nullptr; }
+inline Unit const* Object::ToUnit() const { return typeId == TYPEID_UNIT || typeId == TYPEID_PLAYER ? static_cast<Unit const*>(this) : nullptr; }
+inline Player* Object::ToPlayer() { return typeId == TYPEID_PLAYER ? static_cast<Player*>(this) : nullptr; }
+inline Player const* Object::ToPlayer() const { return typeId == TYPEID_PLAYER ? static_cast<Player const*>(this) : nullptr; }
+inline Creature* Object::ToCreature() { return typeId == TYPEID_UNIT ? static_cast<Creature*>(this) : nullptr; }
+inline Creature const* Object::ToCreature() const { return typeId == TYPEID_UNIT ? static_cast<Creature const*>(this) : nullptr; }
+inline GameObject* Object::ToGameObject() { return typeId == TYPEID_GAMEOBJECT ? static_cast<GameObject*>(this) : nullptr; }
+inline GameObject const* Object::ToGameObject() const { return typeId == TYPEID_GAMEOBJECT ? static_cast<GameObject const*>(this) : nullptr; }
+inline Corpse* Object::ToCorpse() { return typeId == TYPEID_CORPSE ? static_cast<Corpse*>(this) : nullptr; }
+inline Corpse const* Object::ToCorpse() const { return typeId == TYPEID_CORPSE ? static_cast<Corpse const*>(this) : nullptr; }
+
+class Item : public Object
+{
+public:
+    Item(uint32 entry, ObjectGuid guid) : Object(TYPEID_ITEM, guid, entry) { }
+    Item(uint32 entry, uint32 lowGuid) : Item(entry, ObjectGuid(HIGHGUID_ITEM, lowGuid)) { }
+
+    ItemPrototype const* GetProto() const { return nullptr; }
+};
+
+class CreatureAI
+{
+public:
+    explicit CreatureAI(Creature* creature) : m_creature(creature) { }
+    virtual ~CreatureAI() { }
+
+    virtual void UpdateAI(const uint32 /*diff*/) { }
+    virtual void EnterCombat(Unit* /*enemy*/) { }
+    virtual void DamageTaken(Unit* /*doneBy*/, uint32& /*damage*/) { }
+    virtual void JustDied(Unit* /*killer*/) { }
+    virtual void KilledUnit(Unit* /*victim*/) { }
+    virtual void JustSummoned(Creature* /*summoned*/) { }
+    virtual void SummonedCreatureDespawn(Creature* /*summoned*/) { }
+    virtual void MovementInform(uint32 /*movementType*/, uint32 /*data*/) { }
+    virtual void AttackStart(Unit* /*enemy*/) { }
+    virtual void EnterEvadeMode() { }
+    virtual void JustRespawned() { }
+    virtual void JustReachedHome() { }
+    virtual void ReceiveEmote(Player* /*player*/, uint32 /*emoteId*/) { }
+    virtual void CorpseRemoved(uint32& /*respawnDelay*/) { }
+    virtual bool IsVisible(Unit* /*who*/) const { return false; }
+    virtual void MoveInLineOfSight(Unit* /*who*/) { }
+    virtual void SpellHit(Unit* /*caster*/, SpellEntry const* /*spell*/) { }
+    virtual void SpellHitTarget(Unit* /*target*/, SpellEntry const* /*spell*/) { }
+
+protected:
+    Creature* const m_creature;
+};
+
+class InstanceData
+{
+public:
+    explicit InstanceData(Map* map) : instance(map) { }
+    virtual ~InstanceData() { }
+
+    virtual void Initialize() { }
+    virtual void Load(const char* /*data*/) { }
+    virtual const char* Save() const { return nullptr; }
+    virtual void Update(uint32 /*diff*/) { }
+    virtual bool IsEncounterInProgress() const { return false; }
+    virtual void OnPlayerEnter(Player* /*player*/) { }
+    virtual void OnObjectCreate(GameObject* /*gameobject*/) { }
+    virtual void OnCreatureCreate(Creature* /*creature*/) { }
+    virtual uint32 GetData(uint32 /*type*/) const { return 0; }
+    virtual void SetData(uint32 /*type*/, uint32 /*data*/) { }
+    virtual uint64 GetData64(uint32 /*type*/) const { return 0; }
+    virtual void SetData64(uint32 /*type*/, uint64 /*data*/) { }
+
+    Map* instance;
+};
+
+class Map
+{
+public:
+    Map(uint32 id, uint32 instanceId) : id(id), instanceId(instanceId), eluna(nullptr) { }
+
+    uint32 GetId() const { return id; }
+    uint32 GetInstanceId() const { return instanceId; }
+    bool Instanceable() const { return instanceId != 0; }
+    bool IsDungeon() const { return instanceId != 0; }
+    Eluna* GetEluna() const { return eluna; }
+    void SetEluna(Eluna* value) { eluna = value; }
+
+private:
+    uint32 id;
+    uint32 instanceId;
+    Eluna* eluna;
+};
+
+class WorldPacket
+{
+public:
+    WorldPacket() : opcode(0) { }
+    explicit WorldPacket(uint16 opcode, size_t reserve = 200) : opcode(opcode) { storage.reserve(reserve); }
+
+    uint16 GetOpcode() const { return opcode; }
+    void SetOpcode(uint16 value) { opcode = value; }
+    size_t size() const { return storage.size(); }
+    uint8 const* contents() const { return storage.data(); }
+    void append(uint8 const* src, size_t count) { storage.insert(storage.end(), src, src + count); }
+
+private:
+    uint16 opcode;
+    std::vector<uint8> storage;
+};
+
+#define NUM_MSG_TYPES 0x424
+
+struct SpellEntry
+{
+    uint32 Id;
+};
+
+struct AreaTriggerEntry
+{
+    uint32 id;
+};
+
+struct AuctionEntry
+{
+    uint32 Id;
+    uint32 itemGuidLow;
+    uint32 owner;
+    uint32 startbid;
+    uint32 bid;
+    uint32 buyout;
+    uint32 expireTime;
+    uint32 bidder;
+};
+
+class Channel
+{
+public:
+    explicit Channel(uint32 channelId) : channelId(channelId) { }
+
+    uint32 GetChannelId() const { return channelId; }
+
+private:
+    uint32 channelId;
+};
+
+class ObjectAccessor
+{
+public:
+    static ObjectAccessor& Instance();
+
+    Player* FindPlayer(ObjectGuid guid) const;
+    Player* FindPlayerByLowGUID(uint32 lowGuid) const;
+
+    // Players the mock host created, they are found by their guid
+    void AddPlayer(Player* player);
+    void RemovePlayer(Player* player);
+
+private:
+    std::unordered_map<ObjectGuid, Player*> players;
+};
+
+#define sObjectAccessor ObjectAccessor::Instance()
+
+class AuctionHouseMgr
+{
+public:
+    static AuctionHouseMgr& Instance();
+
+    Item* GetAItem(uint32 /*id*/) { return nullptr; }
+};
+
+#define sAuctionMgr AuctionHouseMgr::Instance()
+
+struct CreatureInfo
+{
+    uint32 Entry;
+};
+
+struct GameObjectInfo
+{
+    uint32 id;
+};
+
+struct ItemPrototype
+{
+    uint32 ItemId;
+};
+
+/*
+ * Every entry exists, so scripts can register entry hooks for any entry.
+ */
+class ObjectMgr
+{
+public:
+    static ObjectMgr& Instance();
+
+    CreatureInfo const* GetCreatureTemplate(uint32 entry);
+    GameObjectInfo const* GetGameObjectInfo(uint32 entry);
+    ItemPrototype const* GetItemPrototype(uint32 entry);
+
+private:
+    std::map<uint32, CreatureInfo> creatures;
+    std::map<uint32, GameObjectInfo> gameObjects;
+    std::map<uint32, ItemPrototype> items;
+};
+
+#define sObjectMgr ObjectMgr::Instance()
+
+class World
+{
+public:
+    static World& Instance();
+
+    Eluna* GetEluna() const { return eluna; }
+    void SetEluna(Eluna* value) { eluna = value; }
+
+private:
+    Eluna* eluna = nullptr;
+};
+
+#define sWorld World::Instance()
+
+class MapManager
+{
+public:
+    static MapManager& Instance();
+
+    void DoForAllMaps(std::function<void(Map*)> const& worker);
+
+    Map* CreateMap(uint32 id, uint32 instanceId);
+
+private:
+    std::list<Map> maps;
+};
+
+#define sMapMgr MapManager::Instance()
+
+#endif
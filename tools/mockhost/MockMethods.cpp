@@ -0,0 +1,519 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+// Eluna
+#include "LuaEngine.h"
+#include "BindingMap.h"
+#include "ElunaBenchmark.h"
+#include "ElunaEventMgr.h"
+#include "ElunaHookTrace.h"
+#include "ElunaIncludes.h"
+#include "ElunaTemplate.h"
+#include "ElunaUtility.h"
+#include "LuaValue.h"
+
+/*
+ * The methods scripts run by the mock host can call. Only a small part of the core's tables is
+ *   mirrored here: registering handlers, timed events, printing and the engine tooling,
+ *   and the getters of the mock objects.
+ */
+namespace LuaGlobalFunctions
+{
+    int GetLuaEngine(Eluna* E)
+    {
+        E->Push("ElunaEngine");
+        return 1;
+    }
+
+    int GetCoreName(Eluna* E)
+    {
+        E->Push("MockHost");
+        return 1;
+    }
+
+    int GetStateMapId(Eluna* E)
+    {
+        E->Push(E->GetBoundMapId());
+        return 1;
+    }
+
+    int GetStateInstanceId(Eluna* E)
+    {
+        E->Push(E->GetBoundInstanceId());
+        return 1;
+    }
+
+    int GetPlayerByGUID(Eluna* E)
+    {
+        ObjectGuid guid = E->CHECKVAL<ObjectGuid>(1);
+        E->Push(sObjectAccessor.FindPlayer(guid));
+        return 1;
+    }
+
+    int GetCurrTime(Eluna* E)
+    {
+        E->Push(ElunaUtil::GetCurrTime());
+        return 1;
+    }
+
+    int GetTimeDiff(Eluna* E)
+    {
+        uint32 oldtimems = E->CHECKVAL<uint32>(1);
+
+        E->Push(ElunaUtil::GetTimeDiff(oldtimems));
+        return 1;
+    }
+
+    static int RegisterEntryHelper(Eluna* E, int regtype)
+    {
+        uint32 id = E->CHECKVAL<uint32>(1);
+        uint32 ev = E->CHECKVAL<uint32>(2);
+        luaL_checktype(E->L, 3, LUA_TFUNCTION);
+        uint32 shots = E->CHECKVAL<uint32>(4, 0);
+
+        lua_pushvalue(E->L, 3);
+        int functionRef = ELUNA_REF(E->L, ELUNA_REF_BINDING);
+        if (functionRef >= 0)
+            return E->Register(regtype, id, ObjectGuid(), 0, ev, functionRef, shots);
+        else
+            luaL_argerror(E->L, 3, "unable to make a ref to function");
+        return 0;
+    }
+
+    static int RegisterEventHelper(Eluna* E, int regtype)
+    {
+        uint32 ev = E->CHECKVAL<uint32>(1);
+        luaL_checktype(E->L, 2, LUA_TFUNCTION);
+        uint32 shots = E->CHECKVAL<uint32>(3, 0);
+
+        lua_pushvalue(E->L, 2);
+        int functionRef = ELUNA_REF(E->L, ELUNA_REF_BINDING);
+        if (functionRef >= 0)
+            return E->Register(regtype, 0, ObjectGuid(), 0, ev, functionRef, shots);
+        else
+            luaL_argerror(E->L, 2, "unable to make a ref to function");
+        return 0;
+    }
+
+    static int RegisterUniqueHelper(Eluna* E, int regtype)
+    {
+        ObjectGuid guid = E->CHECKVAL<ObjectGuid>(1);
+        uint32 instanceId = E->CHECKVAL<uint32>(2);
+        uint32 ev = E->CHECKVAL<uint32>(3);
+        luaL_checktype(E->L, 4, LUA_TFUNCTION);
+        uint32 shots = E->CHECKVAL<uint32>(5, 0);
+
+        lua_pushvalue(E->L, 4);
+        int functionRef = ELUNA_REF(E->L, ELUNA_REF_BINDING);
+        if (functionRef >= 0)
+            return E->Register(regtype, 0, guid, instanceId, ev, functionRef, shots);
+        else
+            luaL_argerror(E->L, 4, "unable to make a ref to function");
+        return 0;
+    }
+
+    int RegisterServerEvent(Eluna* E)
+    {
+        return RegisterEventHelper(E, Hooks::REGTYPE_SERVER);
+    }
+
+    int RegisterPlayerEvent(Eluna* E)
+    {
+        return RegisterEventHelper(E, Hooks::REGTYPE_PLAYER);
+    }
+
+    int RegisterMapEvent(Eluna* E)
+    {
+        return RegisterEntryHelper(E, Hooks::REGTYPE_MAP);
+    }
+
+    int RegisterInstanceEvent(Eluna* E)
+    {
+        return RegisterEntryHelper(E, Hooks::REGTYPE_INSTANCE);
+    }
+
+    int RegisterCreatureEvent(Eluna* E)
+    {
+        return RegisterEntryHelper(E, Hooks::REGTYPE_CREATURE);
+    }
+
+    int RegisterUniqueCreatureEvent(Eluna* E)
+    {
+        return RegisterUniqueHelper(E, Hooks::REGTYPE_CREATURE_UNIQUE);
+    }
+
+    int RegisterGameObjectEvent(Eluna* E)
+    {
+        return RegisterEntryHelper(E, Hooks::REGTYPE_GAMEOBJECT);
+    }
+
+    int CreateLuaEvent(Eluna* E)
+    {
+        luaL_checktype(E->L, 1, LUA_TFUNCTION);
+        uint32 min, max;
+        if (lua_istable(E->L, 2))
+        {
+            E->Push(1);
+            lua_gettable(E->L, 2);
+            min = E->CHECKVAL<uint32>(-1);
+            E->Push(2);
+            lua_gettable(E->L, 2);
+            max = E->CHECKVAL<uint32>(-1);
+            lua_pop(E->L, 2);
+        }
+        else
+            min = max = E->CHECKVAL<uint32>(2);
+        uint32 repeats = E->CHECKVAL<uint32>(3, 1);
+
+        if (min > max)
+            return luaL_argerror(E->L, 2, "min is bigger than max delay");
+
+        lua_pushvalue(E->L, 1);
+        int functionRef = ELUNA_REF(E->L, ELUNA_REF_TIMED_EVENT);
+        if (functionRef != LUA_REFNIL && functionRef != LUA_NOREF)
+        {
+            E->eventMgr->GetGlobalProcessor(GLOBAL_EVENTS)->AddEvent(functionRef, min, max, repeats);
+            E->Push(functionRef);
+        }
+        return 1;
+    }
+
+    int RemoveEventById(Eluna* E)
+    {
+        int eventId = E->CHECKVAL<int>(1);
+        bool all_Events = E->CHECKVAL<bool>(2, false);
+
+        if (all_Events)
+            E->eventMgr->SetEventState(eventId, LUAEVENT_STATE_ABORT);
+        else
+            E->eventMgr->GetGlobalProcessor(GLOBAL_EVENTS)->SetState(eventId, LUAEVENT_STATE_ABORT);
+        return 0;
+    }
+
+    int ReloadEluna(Eluna* E)
+    {
+        E->ReloadEluna();
+        return 0;
+    }
+
+    int RunBenchmarks(Eluna* E)
+    {
+        WorldObject* obj = E->CHECKOBJ<WorldObject>(1, false);
+        uint32 iterations = E->CHECKVAL<uint32>(2, 100000);
+
+        lua_newtable(E->L);
+        for (ElunaBenchmark::Result const& result : ElunaBenchmark::Run(E, obj, iterations))
+        {
+            E->Push(result.nanoseconds);
+            lua_setfield(E->L, -2, result.name.c_str());
+        }
+        return 1;
+    }
+
+    int StartHookTrace(Eluna* E)
+    {
+        std::string path = E->CHECKVAL<std::string>(1);
+        uint32 maxBytes = E->CHECKVAL<uint32>(2, 64 * 1024 * 1024);
+
+        E->hookTrace.reset();
+        E->hookTrace = std::make_unique<ElunaHookTrace>(E, path, maxBytes);
+        if (!E->hookTrace->IsOpen())
+            E->hookTrace.reset();
+
+        E->Push(E->hookTrace != nullptr);
+        return 1;
+    }
+
+    int StopHookTrace(Eluna* E)
+    {
+        E->hookTrace.reset();
+        return 0;
+    }
+
+    static std::string GetStackAsString(Eluna* E)
+    {
+        std::string output;
+        int top = lua_gettop(E->L);
+        for (int i = 1; i <= top; ++i)
+        {
+            if (lua_isstring(E->L, i))
+            {
+                output += lua_tostring(E->L, i);
+            }
+            else
+            {
+                lua_getglobal(E->L, "tostring");
+                lua_pushvalue(E->L, i);
+                lua_call(E->L, 1, 1);
+                output += lua_tostring(E->L, -1);
+                lua_pop(E->L, 1);
+            }
+
+            if (i < top)
+                output += "\t";
+        }
+        return output;
+    }
+
+    int PrintInfo(Eluna* E)
+    {
+        ELUNA_LOG_INFO("%s", GetStackAsString(E).c_str());
+        return 0;
+    }
+
+    int PrintError(Eluna* E)
+    {
+        ELUNA_LOG_ERROR("%s", GetStackAsString(E).c_str());
+        return 0;
+    }
+
+    int PrintDebug(Eluna* E)
+    {
+        ELUNA_LOG_DEBUG("%s", GetStackAsString(E).c_str());
+        return 0;
+    }
+
+    ElunaRegister<> GlobalMethods[] =
+    {
+        { "GetLuaEngine", &LuaGlobalFunctions::GetLuaEngine },
+        { "GetCoreName", &LuaGlobalFunctions::GetCoreName },
+        { "GetStateMapId", &LuaGlobalFunctions::GetStateMapId },
+        { "GetStateInstanceId", &LuaGlobalFunctions::GetStateInstanceId },
+        { "GetPlayerByGUID", &LuaGlobalFunctions::GetPlayerByGUID },
+        { "GetCurrTime", &LuaGlobalFunctions::GetCurrTime },
+        { "GetTimeDiff", &LuaGlobalFunctions::GetTimeDiff },
+        { "RegisterServerEvent", &LuaGlobalFunctions::RegisterServerEvent },
+        { "RegisterPlayerEvent", &LuaGlobalFunctions::RegisterPlayerEvent },
+        { "RegisterMapEvent", &LuaGlobalFunctions::RegisterMapEvent },
+        { "RegisterInstanceEvent", &LuaGlobalFunctions::RegisterInstanceEvent },
+        { "RegisterCreatureEvent", &LuaGlobalFunctions::RegisterCreatureEvent },
+        { "RegisterUniqueCreatureEvent", &LuaGlobalFunctions::RegisterUniqueCreatureEvent },
+        { "RegisterGameObjectEvent", &LuaGlobalFunctions::RegisterGameObjectEvent },
+        { "CreateLuaEvent", &LuaGlobalFunctions::CreateLuaEvent },
+        { "RemoveEventById", &LuaGlobalFunctions::RemoveEventById },
+        { "ReloadEluna", &LuaGlobalFunctions::ReloadEluna },
+        { "RunBenchmarks", &LuaGlobalFunctions::RunBenchmarks },
+        { "StartHookTrace", &LuaGlobalFunctions::StartHookTrace },
+        { "StopHookTrace", &LuaGlobalFunctions::StopHookTrace },
+        { "PrintInfo", &LuaGlobalFunctions::PrintInfo },
+        { "PrintError", &LuaGlobalFunctions::PrintError },
+        { "PrintDebug", &LuaGlobalFunctions::PrintDebug }
+    };
+}
+
+namespace LuaObject
+{
+    int GetEntry(Eluna* E, Object* obj)
+    {
+        E->Push(obj->GetEntry());
+        return 1;
+    }
+
+    int GetGUID(Eluna* E, Object* obj)
+    {
+        E->Push(obj->GET_GUID());
+        return 1;
+    }
+
+    int GetGUIDLow(Eluna* E, Object* obj)
+    {
+        E->Push(obj->GetGUIDLow());
+        return 1;
+    }
+
+    int GetTypeId(Eluna* E, Object* obj)
+    {
+        E->Push(obj->GetTypeId());
+        return 1;
+    }
+
+    ElunaRegister<Object> ObjectMethods[] =
+    {
+        { "GetEntry", &LuaObject::GetEntry },
+        { "GetGUID", &LuaObject::GetGUID },
+        { "GetGUIDLow", &LuaObject::GetGUIDLow },
+        { "GetTypeId", &LuaObject::GetTypeId }
+    };
+}
+
+namespace LuaWorldObject
+{
+    int GetName(Eluna* E, WorldObject* obj)
+    {
+        E->Push(obj->GetName());
+        return 1;
+    }
+
+    int GetMap(Eluna* E, WorldObject* obj)
+    {
+        E->Push(obj->GetMap());
+        return 1;
+    }
+
+    int GetMapId(Eluna* E, WorldObject* obj)
+    {
+        E->Push(obj->GetMapId());
+        return 1;
+    }
+
+    int GetX(Eluna* E, WorldObject* obj)
+    {
+        E->Push(obj->GetPositionX());
+        return 1;
+    }
+
+    int GetY(Eluna* E, WorldObject* obj)
+    {
+        E->Push(obj->GetPositionY());
+        return 1;
+    }
+
+    int GetZ(Eluna* E, WorldObject* obj)
+    {
+        E->Push(obj->GetPositionZ());
+        return 1;
+    }
+
+    ElunaRegister<WorldObject> WorldObjectMethods[] =
+    {
+        { "GetName", &LuaWorldObject::GetName },
+        { "GetMap", &LuaWorldObject::GetMap },
+        { "GetMapId", &LuaWorldObject::GetMapId },
+        { "GetX", &LuaWorldObject::GetX },
+        { "GetY", &LuaWorldObject::GetY },
+        { "GetZ", &LuaWorldObject::GetZ }
+    };
+}
+
+namespace LuaUnit
+{
+    int GetHealth(Eluna* E, Unit* unit)
+    {
+        E->Push(unit->GetHealth());
+        return 1;
+    }
+
+    int GetLevel(Eluna* E, Unit* unit)
+    {
+        E->Push(unit->GetLevel());
+        return 1;
+    }
+
+    int IsAlive(Eluna* E, Unit* unit)
+    {
+        E->Push(unit->IsAlive());
+        return 1;
+    }
+
+    ElunaRegister<Unit> UnitMethods[] =
+    {
+        { "GetHealth", &LuaUnit::GetHealth },
+        { "GetLevel", &LuaUnit::GetLevel },
+        { "IsAlive", &LuaUnit::IsAlive }
+    };
+}
+
+namespace LuaMap
+{
+    int GetMapId(Eluna* E, Map* map)
+    {
+        E->Push(map->GetId());
+        return 1;
+    }
+
+    int GetInstanceId(Eluna* E, Map* map)
+    {
+        E->Push(map->GetInstanceId());
+        return 1;
+    }
+
+    ElunaRegister<Map> MapMethods[] =
+    {
+        { "GetMapId", &LuaMap::GetMapId },
+        { "GetInstanceId", &LuaMap::GetInstanceId }
+    };
+}
+
+namespace LuaPacket
+{
+    int GetOpcode(Eluna* E, WorldPacket* packet)
+    {
+        E->Push(packet->GetOpcode());
+        return 1;
+    }
+
+    int GetSize(Eluna* E, WorldPacket* packet)
+    {
+        E->Push(packet->size());
+        return 1;
+    }
+
+    ElunaRegister<WorldPacket> PacketMethods[] =
+    {
+        { "GetOpcode", &LuaPacket::GetOpcode },
+        { "GetSize", &LuaPacket::GetSize }
+    };
+}
+
+// The MaNGOS 64-bit value types need nothing from the core
+#include "methods/Mangos/BigIntMethods.h"
+
+void RegisterMethods(Eluna* E)
+{
+    ElunaTemplate<>::SetMethods(E, LuaGlobalFunctions::GlobalMethods);
+
+    ElunaTemplate<Object>::Register(E, "Object");
+    ElunaTemplate<Object>::SetMethods(E, LuaObject::ObjectMethods);
+
+    ElunaTemplate<WorldObject>::Register(E, "WorldObject");
+    ElunaTemplate<WorldObject>::SetMethods(E, LuaObject::ObjectMethods);
+    ElunaTemplate<WorldObject>::SetMethods(E, LuaWorldObject::WorldObjectMethods);
+
+    ElunaTemplate<Unit>::Register(E, "Unit");
+    ElunaTemplate<Unit>::SetMethods(E, LuaObject::ObjectMethods);
+    ElunaTemplate<Unit>::SetMethods(E, LuaWorldObject::WorldObjectMethods);
+    ElunaTemplate<Unit>::SetMethods(E, LuaUnit::UnitMethods);
+
+    ElunaTemplate<Player>::Register(E, "Player");
+    ElunaTemplate<Player>::SetMethods(E, LuaObject::ObjectMethods);
+    ElunaTemplate<Player>::SetMethods(E, LuaWorldObject::WorldObjectMethods);
+    ElunaTemplate<Player>::SetMethods(E, LuaUnit::UnitMethods);
+
+    ElunaTemplate<Creature>::Register(E, "Creature");
+    ElunaTemplate<Creature>::SetMethods(E, LuaObject::ObjectMethods);
+    ElunaTemplate<Creature>::SetMethods(E, LuaWorldObject::WorldObjectMethods);
+    ElunaTemplate<Creature>::SetMethods(E, LuaUnit::UnitMethods);
+
+    ElunaTemplate<GameObject>::Register(E, "GameObject");
+    ElunaTemplate<GameObject>::SetMethods(E, LuaObject::ObjectMethods);
+    ElunaTemplate<GameObject>::SetMethods(E, LuaWorldObject::WorldObjectMethods);
+
+    ElunaTemplate<Corpse>::Register(E, "Corpse");
+    ElunaTemplate<Corpse>::SetMethods(E, LuaObject::ObjectMethods);
+    ElunaTemplate<Corpse>::SetMethods(E, LuaWorldObject::WorldObjectMethods);
+
+    ElunaTemplate<Item>::Register(E, "Item");
+    ElunaTemplate<Item>::SetMethods(E, LuaObject::ObjectMethods);
+
+    ElunaTemplate<Map>::Register(E, "Map");
+    ElunaTemplate<Map>::SetMethods(E, LuaMap::MapMethods);
+
+    ElunaTemplate<WorldPacket>::Register(E, "WorldPacket");
+    ElunaTemplate<WorldPacket>::SetMethods(E, LuaPacket::PacketMethods);
+
+#if !defined ELUNA_NATIVE_INT64
+    ElunaTemplate<long long>::Register(E, "long long");
+    ElunaTemplate<long long>::SetMethods(E, LuaBigInt::LongLongMethods);
+
+    ElunaTemplate<unsigned long long>::Register(E, "unsigned long long");
+    ElunaTemplate<unsigned long long>::SetMethods(E, LuaBigInt::ULongLongMethods);
+
+    ElunaTemplate<ObjectGuid>::Register(E, "ObjectGuid");
+    ElunaTemplate<ObjectGuid>::SetMethods(E, LuaBigInt::ObjectGuidMethods);
+#endif
+
+    LuaVal::Register(E->L);
+}
@@ -0,0 +1,207 @@
+/*
+* Copyright (C) 2010 - 2025 Eluna Lua Engine <https://elunaluaengine.github.io/>
+* This program is free software licensed under GPL version 3
+* Please see the included DOCS/LICENSE.md for more information
+*/
+
+/*
+ * Runs the scripts of a directory in a world state without a core.
+ *
+ *     eluna-mockhost <script dir> [--set <key>=<value>]... [--updates <count>] [--bench <iterations>] [--reload-bench <iterations>] [--quiet] [--debug]
+ *     eluna-mockhost <script dir> --replay <trace> [--set <key>=<value>]... [--quiet] [--debug]
+ *
+ * The state is started, updated `--updates` times with a 50 millisecond diff and shut down.
+ *   Every update runs the timed events, the world update hook and the AI update hook of a creature
+ *   of entry 1, so scripts can register server, creature and timed events as on a server.
+ *   --set sets an Eluna.* configuration value before the state is created.
+ *
+ * --bench runs the engine microbenchmarks with that creature after the updates, --reload-bench
+ *   reloads the state that many times. Both print `name iterations nanoseconds` lines.
+ *
+ * --replay replays a trace recorded with StartHookTrace on a server instead, see ElunaHookTrace.
+ *   The state only loads the scripts and is not started or updated, the recorded hooks are all it sees.
+ *   Recorded objects are recreated as mock objects of the same type and GUID. The statistics are printed
+ *   and the exit code is 1 if any handler returned something else than it did on the server.
+ */
+
+#include "LuaEngine.h"
+#include "ElunaBenchmark.h"
+#include "ElunaConfig.h"
+#include "ElunaHookTrace.h"
+#include "ElunaLoader.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    int Usage()
+    {
+        fprintf(stderr, "usage: eluna-mockhost <script dir> [--set <key>=<value>]... [--updates <count>] [--bench <iterations>] [--reload-bench <iterations>] [--quiet] [--debug]\n");
+        fprintf(stderr, "       eluna-mockhost <script dir> --replay <trace> [--set <key>=<value>]... [--quiet] [--debug]\n");
+        return 2;
+    }
+
+    // The objects of a replay, created the first time a trace passes them and kept until it ends
+    class ReplayObjects
+    {
+    public:
+        explicit ReplayObjects(Map* map) : map(map) { }
+
+        Object* Get(std::string const& typeName, uint64 rawGuid)
+        {
+            std::unique_ptr<Object>& obj = objects[rawGuid];
+            if (!obj)
+                obj = Create(typeName, ObjectGuid(rawGuid));
+            return obj.get();
+        }
+
+    private:
+        std::unique_ptr<Object> Create(std::string const& typeName, ObjectGuid guid)
+        {
+            std::unique_ptr<WorldObject> obj;
+            if (typeName == "Player")
+                obj = std::make_unique<Player>(guid);
+            else if (typeName == "Creature")
+                obj = std::make_unique<Creature>(guid);
+            else if (typeName == "GameObject")
+                obj = std::make_unique<GameObject>(guid);
+            else if (typeName == "Corpse")
+                obj = std::make_unique<Corpse>(guid);
+            else if (typeName == "Item")
+                return std::make_unique<Item>(0, guid);
+            else
+                return nullptr;
+
+            obj->SetName(typeName);
+            obj->SetMap(map);
+            return obj;
+        }
+
+        Map* map;
+        std::unordered_map<uint64, std::unique_ptr<Object>> objects;
+    };
+
+    int Replay(Eluna* E, Map* map, std::string const& path)
+    {
+        ReplayObjects objects(map);
+        ElunaHookTrace::ObjectFactory factory = [&objects](std::string const& typeName, uint64 guid)
+        {
+            return objects.Get(typeName, guid);
+        };
+
+        ElunaHookTrace::ReplayStats stats;
+        std::string error;
+        if (!ElunaHookTrace::Replay(E, path, factory, stats, error))
+        {
+            fprintf(stderr, "eluna-mockhost: %s\n", error.c_str());
+            return 1;
+        }
+
+        printf("hooks %u skipped %u handlers %u mismatches %u elapsed %.3f ms\n",
+            stats.hooks, stats.skipped, stats.handlers, stats.mismatches, stats.elapsed / 1000.0);
+        return stats.mismatches ? 1 : 0;
+    }
+
+    void PrintResult(ElunaBenchmark::Result const& result)
+    {
+        printf("%-24s %10u %12.1f\n", result.name.c_str(), result.iterations, result.nanoseconds);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+        return Usage();
+
+    uint32 updates = 1;
+    uint32 bench = 0;
+    uint32 reloadBench = 0;
+    std::string replay;
+    sConfig.Set("Eluna.Enabled", "1");
+    sConfig.Set("Eluna.ScriptPath", argv[1]);
+    for (int i = 2; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--set") && i + 1 < argc)
+        {
+            char const* setting = argv[++i];
+            char const* separator = strchr(setting, '=');
+            if (!separator)
+                return Usage();
+            sConfig.Set(std::string(setting, separator), separator + 1);
+        }
+        else if (!strcmp(argv[i], "--updates") && i + 1 < argc)
+            updates = uint32(strtoul(argv[++i], nullptr, 10));
+        else if (!strcmp(argv[i], "--bench") && i + 1 < argc)
+            bench = uint32(strtoul(argv[++i], nullptr, 10));
+        else if (!strcmp(argv[i], "--reload-bench") && i + 1 < argc)
+            reloadBench = uint32(strtoul(argv[++i], nullptr, 10));
+        else if (!strcmp(argv[i], "--replay") && i + 1 < argc)
+            replay = argv[++i];
+        else if (!strcmp(argv[i], "--quiet"))
+            sLog.quiet = true;
+        else if (!strcmp(argv[i], "--debug"))
+            sLog.debug = true;
+        else
+            return Usage();
+    }
+
+    sElunaConfig->Initialize();
+    sElunaLoader->LoadScripts();
+
+    Map* map = sMapMgr.CreateMap(0, 0);
+    Eluna* E = new Eluna(nullptr);
+    sWorld.SetEluna(E);
+
+    if (!replay.empty())
+    {
+        int result = Replay(E, map, replay);
+        sWorld.SetEluna(nullptr);
+        delete E;
+        return result;
+    }
+
+    Player player(1);
+    player.SetName("Player");
+    player.SetMap(map);
+    sObjectAccessor.AddPlayer(&player);
+
+    Creature creature(1, 1);
+    creature.SetName("Creature");
+    creature.SetMap(map);
+    creature.Relocate(1.0f, 1.0f, 0.0f);
+
+    E->OnStartup();
+    E->OnAddToWorld(&creature);
+    E->OnPlayerEnter(map, &player);
+
+    for (uint32 i = 0; i < updates; ++i)
+    {
+        E->UpdateEluna(50);
+        E->OnWorldUpdate(50);
+        E->UpdateAI(&creature, 50);
+    }
+
+    if (bench)
+    {
+        for (ElunaBenchmark::Result const& result : ElunaBenchmark::Run(E, &creature, bench))
+            PrintResult(result);
+    }
+
+    if (reloadBench)
+        PrintResult(ElunaBenchmark::Reload(E, reloadBench));
+
+    E->OnPlayerLeave(map, &player);
+    E->OnRemoveFromWorld(&creature);
+    E->OnShutdown();
+
+    sObjectAccessor.RemovePlayer(&player);
+    sWorld.SetEluna(nullptr);
+    delete E;
+    return 0;
+}